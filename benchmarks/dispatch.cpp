@@ -0,0 +1,45 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <string>
+
+namespace {
+template <std::size_t I>
+constexpr auto MakeName() {
+  return optica::FixedString<4>(std::array<char, 4>{
+      'o', static_cast<char>('0' + I / 100 % 10),
+      static_cast<char>('0' + I / 10 % 10), static_cast<char>('0' + I % 10)});
+}
+
+template <std::size_t... Is>
+constexpr auto MakeParser(std::index_sequence<Is...>) {
+  return optica::Parser(optica::Opt<MakeName<Is>(), int>()...);
+}
+
+std::string MakeCommand(std::size_t options_count) {
+  std::string result;
+  for (std::size_t i = options_count - 8; i < options_count; ++i) {
+    auto name = std::to_string(1000 + i).substr(1);
+    result += "--o" + name + " " + std::to_string(i) + " ";
+  }
+  return result;
+}
+
+template <std::size_t N>
+void BenchmarkDispatch() {
+  static constexpr auto parser = MakeParser(std::make_index_sequence<N>{});
+  static const std::string command = MakeCommand(N);
+  optica::TokenTape tape{command};
+
+  BENCHMARK("Parse 8 long names, " + std::to_string(N) + " options") {
+    return parser.Parse(tape);
+  };
+}
+}  // namespace
+
+TEST_CASE("Long name dispatch doesn't depend on options count",
+          "[!benchmark]") {
+  BenchmarkDispatch<8>();
+  BenchmarkDispatch<32>();
+  BenchmarkDispatch<64>();
+  BenchmarkDispatch<180>();
+}
@@ -0,0 +1,26 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <stdexcept>
+
+namespace {
+constexpr auto parser = optica::Parser(
+    optica::Opt<"day", int>() | optica::ShortName<"d">(),
+    optica::Opt<"name", std::string>() | optica::ShortName<"n">(),
+    optica::Opt<"week", std::array<int, 3>>() |
+        optica::Arity<optica::Exact<3>>());
+}  // namespace
+
+TEST_CASE("Malformed input is cheap to reject with TryParse",
+          "[!benchmark]") {
+  optica::TokenTape tape{"--day 3 --name bob --month 1,2,3"};
+
+  BENCHMARK("Parse with exception") {
+    try {
+      return parser.Parse(tape).Get<"day">().has_value();
+    } catch (const std::invalid_argument&) {
+      return false;
+    }
+  };
+
+  BENCHMARK("TryParse") { return parser.TryParse(tape).has_value(); };
+}
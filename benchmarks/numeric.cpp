@@ -0,0 +1,110 @@
+#include <catch2/catch_all.hpp>
+#include <charconv>
+#include <optica/optica.hpp>
+#include <string>
+#include <string_view>
+
+namespace {
+constexpr std::array<std::string_view, 8> kValues = {
+    "42", "1048576", "-17", "7", "65535", "123456789", "0", "99"};
+
+int UncheckedParse(std::string_view data) {
+  int value{};
+  std::from_chars(data.data(), data.data() + data.size(), value);
+  return value;
+}
+}  // namespace
+
+TEST_CASE("Checked integers cost about as much as unchecked ones",
+          "[!benchmark]") {
+  BENCHMARK("Unchecked std::from_chars") {
+    int sum = 0;
+    for (auto value : kValues) {
+      sum += UncheckedParse(value);
+    }
+    return sum;
+  };
+
+  BENCHMARK("Checked TypeParser<int>") {
+    int sum = 0;
+    for (auto value : kValues) {
+      int parsed{};
+      if (optica::TypeParser<int>::TryParseValue(
+              optica::Token{value, optica::Token::TokenType::Word},
+              parsed) == optica::ErrorCode::Ok) {
+        sum += parsed;
+      }
+    }
+    return sum;
+  };
+
+  BENCHMARK("Checked with suffix") {
+    std::uint64_t sum = 0;
+    for (auto value : {"4Ki", "2G", "1'000", "0xFF"}) {
+      std::uint64_t parsed{};
+      optica::details::ParseInteger(value, parsed);
+      sum += parsed;
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("Long numeric list is parsed in bulk", "[!benchmark]") {
+  static constexpr auto parser = optica::Parser(
+      optica::Opt<"shards", std::array<std::uint64_t, 4096>>() |
+      optica::Arity<optica::Exact<4096>>());
+  std::string command = "--shards ";
+  for (std::uint64_t i = 0; i < 4096; ++i) {
+    command += std::to_string(i * 1'000'000'007ULL) + ",";
+  }
+  optica::TokenTape tape{command};
+  decltype(parser)::ParseResultType result;
+
+  BENCHMARK("4096 values into array") {
+    return parser.TryParseInto(result, tape).has_value();
+  };
+
+  // Short numbers are the common case, eight digit chunks don't help them
+  std::string shards;
+  for (std::uint64_t i = 0; i < 4096; ++i) {
+    shards += std::to_string(i) + ",";
+  }
+  shards.pop_back();
+  const std::string short_command = "--shards " + shards;
+  optica::TokenTape short_tape{short_command};
+  BENCHMARK("4096 short values from command line") {
+    return parser.TryParseInto(result, short_tape).has_value();
+  };
+
+  const char* argv[] = {"prog", "--shards", shards.c_str()};
+  optica::TokenTape argv_tape{3, argv};
+  BENCHMARK("4096 short values from one argument") {
+    return parser.TryParseInto(result, argv_tape).has_value();
+  };
+}
+
+TEST_CASE("Short floating numbers take exact fast path", "[!benchmark]") {
+  static constexpr std::array<std::string_view, 6> kFloats = {
+      "0.25", "-3.75", "1.5e3", "12e-3", "0.1", "2.718281828"};
+
+  BENCHMARK("std::from_chars") {
+    double sum = 0;
+    for (auto value : kFloats) {
+      double parsed{};
+      std::from_chars(value.data(), value.data() + value.size(), parsed);
+      sum += parsed;
+    }
+    return sum;
+  };
+
+  BENCHMARK("ParseFloatingFast") {
+    double sum = 0;
+    for (auto value : kFloats) {
+      double parsed{};
+      optica::details::ParseFloatingFast(
+          value.data(), value.data() + value.size(), parsed);
+      sum += parsed;
+    }
+    return sum;
+  };
+}
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <array>
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+constexpr std::size_t kProbes = 4096;
+
+template <std::size_t N>
+constexpr std::array<int, N> MakeIntegers(int step) {
+  std::array<int, N> values{};
+  for (std::size_t i = 0; i < N; ++i) {
+    values[i] = static_cast<int>(i) * step;
+  }
+  return values;
+}
+
+template <std::size_t N>
+std::vector<int> MakeProbes(int step) {
+  std::vector<int> probes(kProbes);
+  for (std::size_t i = 0; i < kProbes; ++i) {
+    probes[i] = static_cast<int>((i * 7919) % (N * 2)) * step / 2;
+  }
+  return probes;
+}
+
+template <std::size_t N>
+std::array<std::string_view, N> MakeStrings(std::vector<std::string>& owner) {
+  owner.clear();
+  for (std::size_t i = 0; i < N; ++i) {
+    owner.push_back("variant-" + std::to_string(i * 31));
+  }
+  std::array<std::string_view, N> views{};
+  std::copy(owner.begin(), owner.end(), views.begin());
+  return views;
+}
+
+template <std::size_t N, int Step>
+void BenchmarkIntegers() {
+  static constexpr auto values = MakeIntegers<N>(Step);
+  const auto probes = MakeProbes<N>(Step);
+  const optica::details::VariantSet<int, N> set{values};
+
+  BENCHMARK("Linear search " + std::to_string(N)) {
+    std::size_t found = 0;
+    for (int probe : probes) {
+      found += std::find(values.begin(), values.end(), probe) != values.end();
+    }
+    return found;
+  };
+
+  BENCHMARK((set.IsDense() ? "Bitset " : "Binary search ") +
+            std::to_string(N)) {
+    std::size_t found = 0;
+    for (int probe : probes) {
+      found += set.Contains(probe);
+    }
+    return found;
+  };
+}
+
+template <std::size_t N>
+void BenchmarkStrings() {
+  std::vector<std::string> owner;
+  const auto values = MakeStrings<N>(owner);
+  std::vector<std::string> probes;
+  for (std::size_t i = 0; i < kProbes; ++i) {
+    probes.push_back("variant-" + std::to_string((i * 7919) % (N * 2) * 31));
+  }
+  const optica::details::VariantSet<std::string_view, N> set{values};
+
+  BENCHMARK("Linear search " + std::to_string(N)) {
+    std::size_t found = 0;
+    for (const auto& probe : probes) {
+      found += std::find(values.begin(), values.end(), probe) != values.end();
+    }
+    return found;
+  };
+
+  BENCHMARK("Perfect hash " + std::to_string(N)) {
+    std::size_t found = 0;
+    for (const auto& probe : probes) {
+      found += set.Contains(probe);
+    }
+    return found;
+  };
+}
+}  // namespace
+
+TEST_CASE("Small integer variants are checked by bitset", "[!benchmark]") {
+  BenchmarkIntegers<8, 1>();
+  BenchmarkIntegers<64, 1>();
+}
+
+TEST_CASE("Sparse integer variants are checked by binary search",
+          "[!benchmark]") {
+  BenchmarkIntegers<8, 1009>();
+  BenchmarkIntegers<64, 1009>();
+  BenchmarkIntegers<1024, 1009>();
+}
+
+TEST_CASE("String variants are checked by perfect hash", "[!benchmark]") {
+  BenchmarkStrings<8>();
+  BenchmarkStrings<64>();
+  BenchmarkStrings<1024>();
+}
@@ -0,0 +1,23 @@
+#include <optica/optica.hpp>
+#include <print>
+
+// Built with -fno-exceptions, errors are handled through TryParse only
+int main(int argc, char* argv[]) {
+  constexpr auto parser = optica::Parser(
+      optica::Opt<"day", int>() | optica::ShortName<"d">(),
+      optica::Opt<"name", std::string>() | optica::ShortName<"n">());
+
+  auto result = parser.TryParse(argc, argv);
+  if (!result) {
+    std::println("{}", parser.FormatError(result.error()));
+    return 1;
+  }
+
+  if (auto day = result->Get<"day">()) {
+    std::println("Day is: {}", *day);
+  }
+  if (auto name = result->Get<"name">()) {
+    std::println("Name is: {}", *name);
+  }
+  return 0;
+}
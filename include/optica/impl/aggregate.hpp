@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace optica::details {
+
+/// Maximum number of fields of decoded aggregate
+inline constexpr std::size_t kMaxAggregateFields = 16;
+
+/**
+ * @struct AnyField
+ * @brief Converts to any type, used for probing aggregate initialization
+ */
+struct AnyField {
+  template <typename T>
+  constexpr operator T() const noexcept;
+};
+
+template <typename T, std::size_t... Is>
+constexpr bool IsInitializableWith(std::index_sequence<Is...>) noexcept {
+  return requires { T{(static_cast<void>(Is), AnyField{})...}; };
+}
+
+/**
+ * @brief Counts fields of aggregate
+ *
+ * Number of fields is the largest count of initializers aggregate
+ * accepts. AnyField converts to nested aggregate directly, so brace
+ * elision doesn't split it into its own fields
+ *
+ * @return std::size_t number of fields
+ */
+template <typename T, std::size_t N = kMaxAggregateFields>
+constexpr std::size_t CountFields() noexcept {
+  if constexpr (N == 0) {
+    return 0;
+  } else if constexpr (IsInitializableWith<T>(std::make_index_sequence<N>{})) {
+    return N;
+  } else {
+    return CountFields<T, N - 1>();
+  }
+}
+
+template <typename T>
+struct is_std_array : std::false_type {};
+
+template <typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+/**
+ * @concept DecodableAggregate
+ * @brief Checks if T is aggregate whose fields can be bound
+ */
+template <typename T>
+concept DecodableAggregate =
+    std::is_aggregate_v<T> && std::is_class_v<T> &&
+    !is_std_array<T>::value && CountFields<T>() > 0;
+
+/**
+ * @brief Binds fields of aggregate
+ *
+ * @param value Aggregate
+ * @return std::tuple of references to fields in declaration order
+ */
+template <DecodableAggregate T>
+constexpr auto TieFields(T &value) noexcept {
+  constexpr std::size_t kFields = CountFields<T>();
+  static_assert(kFields <= kMaxAggregateFields);
+  if constexpr (kFields == 1) {
+    auto &[f0] = value;
+    return std::tie(f0);
+  } else if constexpr (kFields == 2) {
+    auto &[f0, f1] = value;
+    return std::tie(f0, f1);
+  } else if constexpr (kFields == 3) {
+    auto &[f0, f1, f2] = value;
+    return std::tie(f0, f1, f2);
+  } else if constexpr (kFields == 4) {
+    auto &[f0, f1, f2, f3] = value;
+    return std::tie(f0, f1, f2, f3);
+  } else if constexpr (kFields == 5) {
+    auto &[f0, f1, f2, f3, f4] = value;
+    return std::tie(f0, f1, f2, f3, f4);
+  } else if constexpr (kFields == 6) {
+    auto &[f0, f1, f2, f3, f4, f5] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5);
+  } else if constexpr (kFields == 7) {
+    auto &[f0, f1, f2, f3, f4, f5, f6] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6);
+  } else if constexpr (kFields == 8) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+  } else if constexpr (kFields == 9) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+  } else if constexpr (kFields == 10) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+  } else if constexpr (kFields == 11) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+  } else if constexpr (kFields == 12) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+  } else if constexpr (kFields == 13) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+  } else if constexpr (kFields == 14) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] =
+        value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12,
+                    f13);
+  } else if constexpr (kFields == 15) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] =
+        value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12,
+                    f13, f14);
+  } else {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14,
+           f15] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12,
+                    f13, f14, f15);
+  }
+}
+
+}  // namespace optica::details
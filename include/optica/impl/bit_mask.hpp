@@ -0,0 +1,154 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace optica::details {
+
+/**
+ * @class BitMask
+ * @brief Fixed size set of bits stored in the smallest fitting words
+ *
+ * Unlike std::bitset mask of 8 bits takes a single byte, so it's
+ * suitable for compact storages
+ *
+ * @tparam N Number of bits
+ */
+template <std::size_t N>
+class BitMask {
+ public:
+  using WordType = std::conditional_t<
+      (N <= 8), std::uint8_t,
+      std::conditional_t<(N <= 16), std::uint16_t,
+                         std::conditional_t<(N <= 32), std::uint32_t,
+                                            std::uint64_t>>>;
+
+  static constexpr std::size_t kWordBits = sizeof(WordType) * 8;
+  static constexpr std::size_t kWords = (N + kWordBits - 1) / kWordBits;
+
+  /**
+   * @brief Checks if bit is set
+   *
+   * @param index Index of the bit
+   * @return bool
+   */
+  [[nodiscard]] constexpr bool Test(std::size_t index) const noexcept {
+    return (words_[index / kWordBits] >> (index % kWordBits)) & 1U;
+  }
+
+  /**
+   * @brief Sets bit
+   *
+   * @param index Index of the bit
+   */
+  constexpr void Set(std::size_t index) noexcept {
+    words_[index / kWordBits] |=
+        static_cast<WordType>(WordType{1} << (index % kWordBits));
+  }
+
+  /**
+   * @brief Clears bit
+   *
+   * @param index Index of the bit
+   */
+  constexpr void Reset(std::size_t index) noexcept {
+    words_[index / kWordBits] &=
+        static_cast<WordType>(~(WordType{1} << (index % kWordBits)));
+  }
+
+  /**
+   * @brief Clears all bits
+   */
+  constexpr void Clear() noexcept { words_.fill(0); }
+
+  /**
+   * @brief Get number of set bits
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] constexpr std::size_t Count() const noexcept {
+    std::size_t result = 0;
+    for (WordType word : words_) {
+      result += std::popcount(word);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Checks if no bit is set
+   *
+   * @return bool
+   */
+  [[nodiscard]] constexpr bool None() const noexcept {
+    for (WordType word : words_) {
+      if (word != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Get index of the lowest set bit
+   *
+   * @return std::size_t index or N if no bit is set
+   */
+  [[nodiscard]] constexpr std::size_t FindFirst() const noexcept {
+    for (std::size_t i = 0; i < kWords; ++i) {
+      if (words_[i] != 0) {
+        return i * kWordBits + std::countr_zero(words_[i]);
+      }
+    }
+    return N;
+  }
+
+  /**
+   * @brief Checks if all bits of other mask are set
+   *
+   * @param other Mask of bits
+   * @return bool
+   */
+  [[nodiscard]] constexpr bool Contains(const BitMask &other) const noexcept {
+    for (std::size_t i = 0; i < kWords; ++i) {
+      if ((words_[i] & other.words_[i]) != other.words_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  constexpr BitMask &operator&=(const BitMask &other) noexcept {
+    for (std::size_t i = 0; i < kWords; ++i) {
+      words_[i] &= other.words_[i];
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Clears bits set in other mask
+   *
+   * @param other Mask of bits
+   * @return BitMask& this mask
+   */
+  constexpr BitMask &Remove(const BitMask &other) noexcept {
+    for (std::size_t i = 0; i < kWords; ++i) {
+      words_[i] &= static_cast<WordType>(~other.words_[i]);
+    }
+    return *this;
+  }
+
+  friend constexpr BitMask operator&(BitMask lhs,
+                                     const BitMask &rhs) noexcept {
+    return lhs &= rhs;
+  }
+
+  constexpr bool operator==(const BitMask &other) const noexcept = default;
+
+ private:
+  std::array<WordType, kWords> words_{};
+};
+
+}  // namespace optica::details
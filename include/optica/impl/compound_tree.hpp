@@ -0,0 +1,231 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "error.hpp"
+#include "scanner.hpp"
+#include "token.hpp"
+
+namespace optica {
+namespace details {
+
+/// Maximum nesting of compound values
+inline constexpr std::size_t kMaxCompoundDepth = 16;
+
+/**
+ * @struct CompoundNodeData
+ * @brief Span of unit in compound token and links to its neighbours
+ *
+ * Nodes are stored in pre-order, so the first child of node follows it
+ */
+struct CompoundNodeData {
+  static constexpr std::uint16_t kNone = 0;
+
+  /// Offset of unit data in token
+  std::uint32_t offset{};
+  /// Size of unit data
+  std::uint32_t size{};
+  /// Index of the next sibling or kNone
+  std::uint16_t next{kNone};
+  /// Number of children
+  std::uint16_t children{};
+  /// Word for plain unit, CompoundName for nested one
+  Token::TokenType type{Token::TokenType::Word};
+};
+
+}  // namespace details
+
+/**
+ * @class CompoundNode
+ * @brief View of node in \ref CompoundTree
+ *
+ * Node of nested value like `{10, 20}` has children, plain unit is a leaf
+ */
+class CompoundNode {
+ public:
+  constexpr CompoundNode(const details::CompoundNodeData *nodes,
+                         const char *data, std::uint16_t index) noexcept
+      : nodes_(nodes), data_(data), index_(index) {}
+
+  /**
+   * @brief Get unit as token
+   *
+   * @return Token of Word type or CompoundName type without brackets
+   */
+  [[nodiscard]] constexpr Token GetToken() const noexcept {
+    const auto &node = nodes_[index_];
+    return Token{std::string_view(data_ + node.offset, node.size), node.type};
+  }
+
+  [[nodiscard]] constexpr bool IsCompound() const noexcept {
+    return nodes_[index_].type == Token::TokenType::CompoundName;
+  }
+
+  /**
+   * @brief Get number of children
+   */
+  [[nodiscard]] constexpr std::size_t GetSize() const noexcept {
+    return nodes_[index_].children;
+  }
+
+  /**
+   * @brief Get first child, valid only if node has children
+   */
+  [[nodiscard]] constexpr CompoundNode GetFirstChild() const noexcept {
+    return {nodes_, data_, static_cast<std::uint16_t>(index_ + 1)};
+  }
+
+  /**
+   * @brief Checks if node has next sibling
+   */
+  [[nodiscard]] constexpr bool HasNext() const noexcept {
+    return nodes_[index_].next != details::CompoundNodeData::kNone;
+  }
+
+  /**
+   * @brief Get next sibling, valid only if HasNext
+   */
+  [[nodiscard]] constexpr CompoundNode GetNext() const noexcept {
+    return {nodes_, data_, nodes_[index_].next};
+  }
+
+ private:
+  const details::CompoundNodeData *nodes_;
+  const char *data_;
+  std::uint16_t index_;
+};
+
+/**
+ * @class CompoundTree
+ * @brief Tree of units of nested compound token
+ *
+ * Token like `eu, {10, 20}, {a, b, c}` is split into tree with three
+ * children of root, two of which have their own children. Tree is built
+ * in one pass over structural symbols found by scanner and lives on
+ * stack, so nested values are decoded without allocations or
+ * scanning units again
+ *
+ * @tparam MaxNodes Capacity of tree, root included
+ */
+template <std::size_t MaxNodes>
+class CompoundTree {
+  static_assert(MaxNodes > 0 && MaxNodes < 0xFFFF);
+
+ public:
+  /**
+   * @brief Builds tree from compound token data
+   *
+   * @param data Data of compound token without outer brackets
+   * @return ErrorCode::TooManyUnits if tree is over capacity or too deep,
+   * ErrorCode::InvalidValue if brackets aren't balanced or nested value
+   * shares unit with other symbols
+   */
+  constexpr ErrorCode Build(std::string_view data) noexcept {
+    using enum ErrorCode;
+    data_ = data.data();
+    const char *begin = data.data();
+    const char *end = begin + data.size();
+
+    nodes_[0] = {.offset = 0,
+                 .size = static_cast<std::uint32_t>(data.size()),
+                 .type = Token::TokenType::CompoundName};
+    size_ = 1;
+    std::array<std::uint16_t, details::kMaxCompoundDepth> parents{};
+    std::array<std::uint16_t, details::kMaxCompoundDepth> last_children{};
+    std::size_t depth = 1;
+
+    // Appends child to the innermost open node
+    auto append = [&](const char *from, const char *to,
+                      Token::TokenType type) -> bool {
+      if (size_ == MaxNodes) {
+        return false;
+      }
+      const auto index = static_cast<std::uint16_t>(size_++);
+      nodes_[index] = {.offset = static_cast<std::uint32_t>(from - begin),
+                       .size = static_cast<std::uint32_t>(to - from),
+                       .type = type};
+      if (last_children[depth - 1] != details::CompoundNodeData::kNone) {
+        nodes_[last_children[depth - 1]].next = index;
+      }
+      last_children[depth - 1] = index;
+      ++nodes_[parents[depth - 1]].children;
+      return true;
+    };
+    auto trim = [](const char *&from, const char *&to) {
+      while (from != to && *from == constants::kSpace) {
+        ++from;
+      }
+      while (to != from && *(to - 1) == constants::kSpace) {
+        --to;
+      }
+    };
+
+    const char *unit = begin;
+    // Unit after closed nested value is already appended
+    bool closed = false;
+    for (const char *it = details::DefaultScanner::FindStructural(begin, end);
+         ; it = details::DefaultScanner::FindStructural(it + 1, end)) {
+      const char symbol = it == end ? constants::kComma : *it;
+      const char *from = unit;
+      const char *to = it;
+      trim(from, to);
+      // Nested value must be the whole unit
+      const bool opens = symbol == constants::kOpenBracket;
+      if (closed ? from != to || opens : from != to && opens) {
+        return InvalidValue;
+      }
+
+      if (opens) {
+        if (depth == details::kMaxCompoundDepth ||
+            !append(it + 1, it + 1, Token::TokenType::CompoundName)) {
+          return TooManyUnits;
+        }
+        parents[depth] = static_cast<std::uint16_t>(size_ - 1);
+        last_children[depth] = details::CompoundNodeData::kNone;
+        ++depth;
+        unit = it + 1;
+        closed = false;
+        continue;
+      }
+
+      const bool last = it == end || symbol == constants::kCloseBracket;
+      if (!closed && !(last && from == to) &&
+          !append(from, to, Token::TokenType::Word)) {
+        return TooManyUnits;
+      }
+      unit = it + 1;
+      closed = false;
+
+      if (it == end) {
+        break;
+      }
+      if (symbol == constants::kCloseBracket) {
+        if (depth == 1) {
+          return InvalidValue;
+        }
+        --depth;
+        auto &node = nodes_[parents[depth]];
+        node.size = static_cast<std::uint32_t>(it - begin) - node.offset;
+        closed = true;
+      }
+    }
+    return depth == 1 ? Ok : InvalidValue;
+  }
+
+  /**
+   * @brief Get root node holding whole token
+   */
+  [[nodiscard]] constexpr CompoundNode GetRoot() const noexcept {
+    return {nodes_.data(), data_, 0};
+  }
+
+ private:
+  std::array<details::CompoundNodeData, MaxNodes> nodes_{};
+  const char *data_{};
+  std::size_t size_{};
+};
+
+}  // namespace optica
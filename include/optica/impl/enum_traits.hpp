@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "perfect_hash.hpp"
+
+namespace optica {
+
+/**
+ * @struct EnumEntry
+ * @brief Name of enumerator
+ *
+ * @tparam Enum Type of enumeration
+ */
+template <typename Enum>
+struct EnumEntry {
+  std::string_view name;
+  Enum value;
+};
+
+/**
+ * @struct EnumTraits
+ * @brief Names of enumerators given in compile time
+ *
+ * Specialization provides `static constexpr std::array kNames` of
+ * \ref EnumEntry. Every enumerator must have a single unique name,
+ * otherwise compilation fails
+ *
+ * @code{.cpp}
+ * enum class Mode { Local, Replicated };
+ *
+ * template <>
+ * struct optica::EnumTraits<Mode> {
+ *   static constexpr std::array kNames = {
+ *       optica::EnumEntry{"local", Mode::Local},
+ *       optica::EnumEntry{"replicated", Mode::Replicated}};
+ * };
+ *
+ * auto parser = optica::Parser(optica::Opt<"mode", Mode>());
+ * @endcode
+ *
+ * @tparam Enum Type of enumeration
+ */
+template <typename Enum>
+struct EnumTraits;
+
+/**
+ * @concept NamedEnum
+ * @brief Checks if enumeration has names given by \ref EnumTraits
+ */
+template <typename Enum>
+concept NamedEnum =
+    std::is_enum_v<Enum> && requires { EnumTraits<Enum>::kNames; };
+
+namespace details {
+
+/**
+ * @struct EnumTable
+ * @brief Perfect hashes from names to enumerators and back
+ *
+ * Both lookups cost one hash and one comparison, no matter how
+ * many enumerators there are
+ *
+ * @tparam Enum Type of enumeration
+ */
+template <NamedEnum Enum>
+struct EnumTable {
+  static constexpr auto &kNames = EnumTraits<Enum>::kNames;
+  static constexpr std::size_t kSize = kNames.size();
+
+  static constexpr std::uint64_t GetValueKey(Enum value) noexcept {
+    return static_cast<std::uint64_t>(std::to_underlying(value));
+  }
+
+  static constexpr PerfectHash<kSize> kByName{[] {
+    std::array<std::uint64_t, kSize> hashes{};
+    for (std::size_t i = 0; i < kSize; ++i) {
+      hashes[i] = HashString(kNames[i].name);
+    }
+    return hashes;
+  }()};
+
+  static constexpr PerfectHash<kSize> kByValue{[] {
+    std::array<std::uint64_t, kSize> keys{};
+    for (std::size_t i = 0; i < kSize; ++i) {
+      keys[i] = GetValueKey(kNames[i].value);
+    }
+    return keys;
+  }()};
+
+  /**
+   * @brief Finds enumerator by name
+   *
+   * @return std::size_t index of entry or kSize
+   */
+  static constexpr std::size_t FindByName(std::string_view name) noexcept {
+    const std::size_t index = kByName.Find(HashString(name));
+    if (index == kSize || kNames[index].name != name) {
+      return kSize;
+    }
+    return index;
+  }
+
+  /**
+   * @brief Finds name of enumerator
+   *
+   * @return std::size_t index of entry or kSize
+   */
+  static constexpr std::size_t FindByValue(Enum value) noexcept {
+    const std::size_t index = kByValue.Find(GetValueKey(value));
+    if (index == kSize || kNames[index].value != value) {
+      return kSize;
+    }
+    return index;
+  }
+};
+
+}  // namespace details
+
+/**
+ * @brief Get name of enumerator
+ *
+ * @param value Enumerator
+ * @return std::string_view name or empty string for unnamed value
+ */
+template <NamedEnum Enum>
+constexpr std::string_view EnumName(Enum value) noexcept {
+  using Table = details::EnumTable<Enum>;
+  const std::size_t index = Table::FindByValue(value);
+  return index == Table::kSize ? std::string_view{}
+                               : Table::kNames[index].name;
+}
+
+}  // namespace optica
+
+/**
+ * @brief Formats named enumerator as its name
+ */
+template <optica::NamedEnum Enum>
+struct std::formatter<Enum, char> {
+  constexpr auto parse(std::format_parse_context &ctx) { return ctx.begin(); }
+
+  template <typename Context>
+  auto format(Enum value, Context &ctx) const {
+    const std::string_view name = optica::EnumName(value);
+    return std::copy(name.begin(), name.end(), ctx.out());
+  }
+};
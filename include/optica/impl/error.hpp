@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace optica {
+
+/**
+ * @brief Codes of errors reported by parser
+ */
+enum class ErrorCode : std::uint8_t {
+  Ok = 0,
+  UnknownArgument,
+  DuplicateOption,
+  UnsupportedToken,
+  NotEnoughValues,
+  TooManyUnits,
+  InvalidValue,
+  OutOfRange,
+  MissingRequired,
+  ExclusiveOptions,
+  MissingDependency,
+  UnexpectedVariant,
+  StringTooLong,
+};
+
+/**
+ * @brief Converts ErrorCode to string
+ *
+ * @param code Code of the error
+ * @return std::string_view human readable description
+ */
+constexpr std::string_view to_string(ErrorCode code) noexcept {
+  using enum ErrorCode;
+  switch (code) {
+    case Ok:
+      return "No error";
+    case UnknownArgument:
+      return "Unknown Argument";
+    case DuplicateOption:
+      return "Option is set more than 1 time";
+    case UnsupportedToken:
+      return "Currently unsupported";
+    case NotEnoughValues:
+      return "Not enough values for option";
+    case TooManyUnits:
+      return "Too many units in compound token";
+    case InvalidValue:
+      return "Invalid value";
+    case OutOfRange:
+      return "Value is out of range";
+    case MissingRequired:
+      return "Required option is missing";
+    case ExclusiveOptions:
+      return "Options are mutually exclusive";
+    case MissingDependency:
+      return "Option requires another option";
+    case UnexpectedVariant:
+      return "Value is not one of variants";
+    case StringTooLong:
+      return "String doesn't fit into inline storage";
+    default:
+      return "Unknown error";
+  }
+}
+
+/**
+ * @struct ParseError
+ * @brief Describes why input can't be parsed
+ *
+ * Error is a plain value, so reporting it costs nothing. Human readable
+ * message is built only on request, see \ref Parser::FormatError
+ */
+struct ParseError {
+  static constexpr std::uint32_t kNoOption =
+      std::numeric_limits<std::uint32_t>::max();
+
+  /// Code of the error
+  ErrorCode code{ErrorCode::Ok};
+  /// Index of the option in parser or kNoOption
+  std::uint32_t option_index{kNoOption};
+  /// Byte offset of the erroneous token from the start of input
+  std::uint32_t offset{};
+
+  constexpr bool operator==(const ParseError &other) const noexcept = default;
+};
+
+namespace details {
+
+/**
+ * @brief Reports error by throwing std::invalid_argument
+ *
+ * Without exceptions the message is printed and program is aborted.
+ * Reaching it during constant evaluation makes compilation fail
+ *
+ * @param message Error message
+ */
+[[noreturn]] inline void ThrowInvalidArgument(const std::string &message) {
+#if __cpp_exceptions
+  throw std::invalid_argument(message);
+#else
+  std::fputs(message.c_str(), stderr);
+  std::fputc('\n', stderr);
+  std::abort();
+#endif
+}
+
+}  // namespace details
+}  // namespace optica
@@ -3,8 +3,11 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <format>
 #include <string>
 #include <string_view>
+#include <type_traits>
 
 namespace optica {
 
@@ -85,4 +88,80 @@ struct FixedString {
  */
 template <std::size_t N>
 FixedString(const char (&str)[N]) -> FixedString<N - 1>;
+
+/**
+ * @class InlineString
+ * @brief String of at most N chars stored inline
+ *
+ * Unlike std::string it never allocates and is trivially copyable, so
+ * parse result holding it can be copied as plain bytes. Data is always
+ * followed by terminal \0
+ *
+ * @tparam N Capacity without terminal \0
+ */
+template <std::size_t N>
+class InlineString {
+ public:
+  using SizeType = std::conditional_t<
+      (N <= 0xFF), std::uint8_t,
+      std::conditional_t<(N <= 0xFFFF), std::uint16_t, std::size_t>>;
+
+  constexpr InlineString() noexcept = default;
+
+  /**
+   * @brief Replaces content of string
+   *
+   * @param value New content
+   * @return bool false if value is longer than N, string isn't changed then
+   */
+  constexpr bool TryAssign(std::string_view value) noexcept {
+    if (value.size() > N) {
+      return false;
+    }
+    std::copy_n(value.data(), value.size(), data_.data());
+    data_[value.size()] = '\0';
+    size_ = static_cast<SizeType>(value.size());
+    return true;
+  }
+
+  [[nodiscard]] constexpr const char *data() const noexcept {
+    return data_.data();
+  }
+
+  [[nodiscard]] constexpr const char *c_str() const noexcept {
+    return data_.data();
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+
+  [[nodiscard]] static constexpr std::size_t capacity() noexcept { return N; }
+
+  constexpr operator std::string_view() const noexcept {
+    return {data_.data(), size_};
+  }
+
+  constexpr bool operator==(std::string_view other) const noexcept {
+    return std::string_view(*this) == other;
+  }
+
+ private:
+  std::array<char, N + 1> data_{};
+  SizeType size_{};
+};
 }  // namespace optica
+
+/**
+ * @brief Formats inline string as its content
+ */
+template <std::size_t N>
+struct std::formatter<optica::InlineString<N>, char> {
+  constexpr auto parse(std::format_parse_context &ctx) { return ctx.begin(); }
+
+  template <typename Context>
+  auto format(const optica::InlineString<N> &value, Context &ctx) const {
+    const std::string_view data = value;
+    return std::copy(data.begin(), data.end(), ctx.out());
+  }
+};
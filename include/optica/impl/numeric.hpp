@@ -0,0 +1,691 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "error.hpp"
+
+namespace optica::details {
+
+/**
+ * @struct Suffix
+ * @brief Multiplier denoted by suffix of number
+ *
+ * Multiplier is a ratio `num / den`, so units smaller than one
+ * like milliseconds are exact
+ */
+struct Suffix {
+  std::string_view name;
+  std::uint64_t num;
+  std::uint64_t den{1};
+};
+
+/**
+ * @brief Size suffixes, decimal `4K` and binary `4Ki`
+ */
+inline constexpr std::array<Suffix, 10> kSizeSuffixes = {{
+    {"K", 1'000ULL},
+    {"M", 1'000'000ULL},
+    {"G", 1'000'000'000ULL},
+    {"T", 1'000'000'000'000ULL},
+    {"P", 1'000'000'000'000'000ULL},
+    {"Ki", 1ULL << 10},
+    {"Mi", 1ULL << 20},
+    {"Gi", 1ULL << 30},
+    {"Ti", 1ULL << 40},
+    {"Pi", 1ULL << 50},
+}};
+
+/**
+ * @brief Duration suffixes as ratio to one second
+ */
+inline constexpr std::array<Suffix, 7> kDurationSuffixes = {{
+    {"ns", 1, 1'000'000'000ULL},
+    {"us", 1, 1'000'000ULL},
+    {"ms", 1, 1'000ULL},
+    {"s", 1},
+    {"min", 60},
+    {"h", 3'600},
+    {"d", 86'400},
+}};
+
+/**
+ * @brief Finds suffix in table
+ *
+ * @param table Table of suffixes
+ * @param name Suffix of number
+ * @return Pointer to suffix or nullptr if it's unknown
+ */
+template <std::size_t N>
+constexpr const Suffix *FindSuffix(const std::array<Suffix, N> &table,
+                                   std::string_view name) noexcept {
+  for (const Suffix &suffix : table) {
+    if (suffix.name == name) {
+      return &suffix;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @concept CheckedInteger
+ * @brief Integer types parsed as numbers
+ *
+ * Character types and bool are excluded, but std::int8_t and
+ * std::uint8_t are numbers
+ */
+template <typename T>
+concept CheckedInteger =
+    std::integral<T> && !std::same_as<T, bool> && !std::same_as<T, char> &&
+    !std::same_as<T, wchar_t> && !std::same_as<T, char8_t> &&
+    !std::same_as<T, char16_t> && !std::same_as<T, char32_t>;
+
+/**
+ * @brief Checks if symbol separates digit groups like `1'000` or `1_000`
+ */
+constexpr bool IsDigitSeparator(char symbol) noexcept {
+  return symbol == '\'' || symbol == '_';
+}
+
+/**
+ * @brief Get value of digit in any base up to 16
+ *
+ * @return unsigned value or 16 if symbol isn't digit
+ */
+constexpr unsigned DigitValue(char symbol) noexcept {
+  const unsigned decimal = static_cast<unsigned char>(symbol) - unsigned{'0'};
+  if (decimal < 10) {
+    return decimal;
+  }
+  const char lower = static_cast<char>(symbol | 0x20);
+  if (lower >= 'a' && lower <= 'f') {
+    return static_cast<unsigned>(lower - 'a' + 10);
+  }
+  return 16;
+}
+
+/**
+ * @brief Integer split into sign, magnitude and suffix
+ */
+struct ScannedInteger {
+  std::uint64_t magnitude{};
+  bool negative{};
+  std::string_view suffix;
+};
+
+/**
+ * @brief Checks if all eight bytes of chunk are decimal digits
+ *
+ * @param chunk Eight symbols loaded in little endian order
+ * @return bool
+ */
+constexpr bool IsEightDigits(std::uint64_t chunk) noexcept {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+          (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+         0x3333333333333333ULL;
+}
+
+/**
+ * @brief Converts eight decimal digits at once
+ *
+ * Digits are combined pairwise inside the register, so conversion takes
+ * three multiplications instead of eight
+ *
+ * @param chunk Eight digits loaded in little endian order
+ * @return std::uint32_t value of digits
+ */
+constexpr std::uint32_t ParseEightDigits(std::uint64_t chunk) noexcept {
+  constexpr std::uint64_t kMask = 0x000000FF000000FFULL;
+  constexpr std::uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr std::uint64_t kMul2 = 1 + (10000ULL << 32);
+  chunk -= 0x3030303030303030ULL;
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >>
+          32;
+  return static_cast<std::uint32_t>(chunk);
+}
+
+/**
+ * @brief Get number of decimal digits the chunk starts with
+ *
+ * Carry out of a non-digit byte only spoils the bytes after it
+ *
+ * @param chunk Eight symbols loaded in little endian order
+ * @return std::size_t from 0 to 8
+ */
+constexpr std::size_t CountLeadingDigits(std::uint64_t chunk) noexcept {
+  const std::uint64_t classes =
+      (chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+      (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4);
+  return static_cast<std::size_t>(
+             std::countr_zero(classes ^ 0x3333333333333333ULL)) /
+         8;
+}
+
+/**
+ * @brief Accumulates plain decimal digits of a short number
+ *
+ * Number inside a longer text is converted by \ref ParseEightDigits
+ * with leading zeros in place of symbols after it, so short numbers
+ * take no branch per digit. There are no signs and no separators,
+ * scan stops after 19 digits, so magnitude always fits into 64 bits
+ *
+ * @param data Text holding the number
+ * @param pos Position of the first digit, moved past the last one
+ * @param magnitude Accumulated value
+ * @return std::size_t number of accumulated digits
+ */
+constexpr std::size_t ScanShortDecimal(std::string_view data,
+                                       std::size_t &pos,
+                                       std::uint64_t &magnitude) noexcept {
+  constexpr std::size_t kMaxDigits = 19;
+  constexpr std::array<std::uint64_t, 8> kScale = {
+      1, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000};
+  std::uint64_t value = 0;
+  std::size_t count = 0;
+  if constexpr (std::endian::native == std::endian::little) {
+    if !consteval {
+      while (data.size() - pos >= 8 && count + 8 <= kMaxDigits) {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, data.data() + pos, sizeof(chunk));
+        const std::size_t digits = CountLeadingDigits(chunk);
+        if (digits == 8) {
+          value = value * 100'000'000ULL + ParseEightDigits(chunk);
+          count += 8;
+          pos += 8;
+          continue;
+        }
+        if (digits != 0) {
+          const unsigned shift = 8 * static_cast<unsigned>(8 - digits);
+          chunk = (chunk << shift) | (0x3030303030303030ULL >> (64 - shift));
+          value = value * kScale[digits] + ParseEightDigits(chunk);
+          count += digits;
+          pos += digits;
+        }
+        magnitude = value;
+        return count;
+      }
+    }
+  }
+  for (; pos != data.size() && count != kMaxDigits; ++pos, ++count) {
+    const unsigned digit =
+        static_cast<unsigned char>(data[pos]) - unsigned{'0'};
+    if (digit >= 10) {
+      break;
+    }
+    value = value * 10 + digit;
+  }
+  magnitude = value;
+  return count;
+}
+
+/**
+ * @brief Accumulates digits of Base skipping separators between them
+ *
+ * @param data Text of the number
+ * @param pos Position of the first digit, moved past the last one
+ * @param magnitude Accumulated value
+ * @param digits Number of accumulated digits
+ * @return ErrorCode
+ */
+template <unsigned Base>
+constexpr ErrorCode ScanDigits(std::string_view data, std::size_t &pos,
+                               std::uint64_t &magnitude,
+                               std::size_t &digits) noexcept {
+  constexpr std::uint64_t kMax = std::numeric_limits<std::uint64_t>::max();
+  // Numbers with fewer digits always fit into 64 bits
+  constexpr std::size_t kSafeDigits = Base == 10 ? 19 : Base == 16 ? 16 : 64;
+  const char *begin = data.data();
+  const char *it = begin + pos;
+  const char *end = begin + data.size();
+  std::uint64_t value = 0;
+  std::size_t count = 0;
+  if constexpr (Base == 10 && std::endian::native == std::endian::little) {
+    if !consteval {
+      // Eight digits at once while result surely fits into 64 bits
+      while (end - it >= 8 && count + 8 <= kSafeDigits) {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, it, sizeof(chunk));
+        if (!IsEightDigits(chunk)) {
+          break;
+        }
+        value = value * 100'000'000ULL + ParseEightDigits(chunk);
+        count += 8;
+        it += 8;
+      }
+    }
+  }
+  for (; it != end; ++it) {
+    const unsigned digit = DigitValue(*it);
+    if (digit >= Base) [[unlikely]] {
+      if (IsDigitSeparator(*it) && count != 0 && it + 1 != end &&
+          DigitValue(*(it + 1)) < Base) {
+        continue;
+      }
+      break;
+    }
+    if (count >= kSafeDigits && value > (kMax - digit) / Base) [[unlikely]] {
+      return ErrorCode::OutOfRange;
+    }
+    value = value * Base + digit;
+    ++count;
+  }
+  pos = static_cast<std::size_t>(it - begin);
+  magnitude = value;
+  digits = count;
+  return ErrorCode::Ok;
+}
+
+/**
+ * @brief Scans sign, base prefix and digits of integer
+ *
+ * Supports `0x` and `0b` prefixes and digit separators between digits.
+ * Everything after the last digit is returned as suffix
+ *
+ * @param data Text of the number
+ * @param result Scanned integer
+ * @return ErrorCode
+ */
+constexpr ErrorCode ScanInteger(std::string_view data,
+                                ScannedInteger &result) noexcept {
+  std::size_t pos = 0;
+  result.negative = false;
+  if (!data.empty() && (data[0] == '-' || data[0] == '+')) {
+    result.negative = data[0] == '-';
+    ++pos;
+  }
+
+  unsigned base = 10;
+  if (data.size() > pos + 2 && data[pos] == '0') {
+    const char prefix = static_cast<char>(data[pos + 1] | 0x20);
+    if (prefix == 'x') {
+      base = 16;
+      pos += 2;
+    } else if (prefix == 'b') {
+      base = 2;
+      pos += 2;
+    }
+  }
+
+  std::uint64_t magnitude = 0;
+  std::size_t digits = 0;
+  ErrorCode code = ErrorCode::Ok;
+  switch (base) {
+    case 16:
+      code = ScanDigits<16>(data, pos, magnitude, digits);
+      break;
+    case 2:
+      code = ScanDigits<2>(data, pos, magnitude, digits);
+      break;
+    default:
+      code = ScanDigits<10>(data, pos, magnitude, digits);
+  }
+  if (code != ErrorCode::Ok) {
+    return code;
+  }
+  if (digits == 0) {
+    return ErrorCode::InvalidValue;
+  }
+  result.magnitude = magnitude;
+  result.suffix = std::string_view(data.data() + pos, data.size() - pos);
+  return ErrorCode::Ok;
+}
+
+/**
+ * @brief Multiplies magnitude by integer suffix with overflow check
+ *
+ * @return ErrorCode
+ */
+constexpr ErrorCode ApplySuffix(const Suffix &suffix,
+                                std::uint64_t &magnitude) noexcept {
+  if (magnitude > std::numeric_limits<std::uint64_t>::max() / suffix.num) {
+    return ErrorCode::OutOfRange;
+  }
+  magnitude *= suffix.num;
+  return ErrorCode::Ok;
+}
+
+/**
+ * @brief Converts sign and magnitude into integer type checking its range
+ *
+ * @return ErrorCode
+ */
+template <CheckedInteger T>
+constexpr ErrorCode NarrowInteger(bool negative, std::uint64_t magnitude,
+                                  T &value) noexcept {
+  using Unsigned = std::make_unsigned_t<T>;
+  constexpr auto kMax =
+      static_cast<std::uint64_t>(std::numeric_limits<T>::max());
+  if (!negative) {
+    if (magnitude > kMax) {
+      return ErrorCode::OutOfRange;
+    }
+    value = static_cast<T>(magnitude);
+    return ErrorCode::Ok;
+  }
+  if constexpr (std::is_unsigned_v<T>) {
+    if (magnitude != 0) {
+      return ErrorCode::OutOfRange;
+    }
+    value = 0;
+  } else {
+    if (magnitude > kMax + 1) {
+      return ErrorCode::OutOfRange;
+    }
+    // Two's complement negation keeps minimal value representable
+    value = static_cast<T>(static_cast<Unsigned>(0U - magnitude));
+  }
+  return ErrorCode::Ok;
+}
+
+/**
+ * @brief Parses integer with range check
+ *
+ * Accepts `-42`, `0xFF`, `0b1010`, `1'000'000`, `4Ki`, `2G`
+ *
+ * @param data Text of the number
+ * @param value Parsed value, unchanged on error
+ * @return ErrorCode
+ */
+template <CheckedInteger T>
+constexpr ErrorCode ParseInteger(std::string_view data, T &value) noexcept {
+  ScannedInteger scanned;
+  if (auto code = ScanInteger(data, scanned); code != ErrorCode::Ok) {
+    return code;
+  }
+  if (!scanned.suffix.empty()) {
+    const Suffix *suffix = FindSuffix(kSizeSuffixes, scanned.suffix);
+    if (suffix == nullptr) {
+      return ErrorCode::InvalidValue;
+    }
+    if (auto code = ApplySuffix(*suffix, scanned.magnitude);
+        code != ErrorCode::Ok) {
+      return code;
+    }
+  }
+  return NarrowInteger(scanned.negative, scanned.magnitude, value);
+}
+
+/// Largest power of ten represented exactly by T
+template <std::floating_point T>
+inline constexpr int kExactPowerOfTen =
+    std::numeric_limits<T>::digits >= 53 ? 22 : 10;
+
+/// Largest mantissa represented exactly by T
+template <std::floating_point T>
+inline constexpr std::uint64_t kExactMantissa =
+    std::uint64_t{1} << std::min(std::numeric_limits<T>::digits, 63);
+
+template <std::floating_point T>
+inline constexpr std::array<T, kExactPowerOfTen<T> + 1> kPowersOfTen = [] {
+  std::array<T, kExactPowerOfTen<T> + 1> powers{};
+  T power = 1;
+  for (auto &value : powers) {
+    value = power;
+    power *= 10;
+  }
+  return powers;
+}();
+
+/**
+ * @brief Converts decimal number with Clinger's fast path
+ *
+ * When mantissa and power of ten are both exact in T, a single
+ * multiplication or division is correctly rounded, so result is the
+ * same as of std::from_chars. Other numbers like `1e300` or `nan` are
+ * left to the caller
+ *
+ * @param it Beginning of the number
+ * @param end End of the text
+ * @param value Parsed value
+ * @return const char* past the number or nullptr if fast path isn't taken
+ */
+template <std::floating_point T>
+constexpr const char *ParseFloatingFast(const char *it, const char *end,
+                                        T &value) noexcept {
+  const bool negative = it != end && *it == '-';
+  if (negative) {
+    ++it;
+  }
+  std::uint64_t mantissa = 0;
+  std::size_t significant = 0;
+  std::size_t digits = 0;
+  int exponent = 0;
+  auto accumulate = [&](char symbol) {
+    mantissa = mantissa * 10 + DigitValue(symbol);
+    significant += mantissa != 0;
+    ++digits;
+    // Mantissa can't overflow, longer numbers are rejected below
+    return significant <= 19;
+  };
+
+  for (; it != end && DigitValue(*it) < 10; ++it) {
+    if (!accumulate(*it)) {
+      return nullptr;
+    }
+  }
+  if (it != end && *it == '.') {
+    for (++it; it != end && DigitValue(*it) < 10; ++it) {
+      if (!accumulate(*it)) {
+        return nullptr;
+      }
+      --exponent;
+    }
+  }
+  if (digits == 0) {
+    return nullptr;
+  }
+  if (it != end && (*it == 'e' || *it == 'E')) {
+    const char *mark = it++;
+    const bool negative_exponent = it != end && *it == '-';
+    if (it != end && (*it == '-' || *it == '+')) {
+      ++it;
+    }
+    int power = 0;
+    const char *first = it;
+    for (; it != end && DigitValue(*it) < 10; ++it) {
+      power = std::min(power * 10 + static_cast<int>(DigitValue(*it)), 9999);
+    }
+    // `1e` is number 1 followed by `e`
+    if (it == first) {
+      it = mark;
+    } else {
+      exponent += negative_exponent ? -power : power;
+    }
+  }
+
+  if (mantissa > kExactMantissa<T> ||
+      (mantissa != 0 && (exponent > kExactPowerOfTen<T> ||
+                         exponent < -kExactPowerOfTen<T>))) {
+    return nullptr;
+  }
+  T result = static_cast<T>(mantissa);
+  if (mantissa != 0) {
+    result = exponent >= 0 ? result * kPowersOfTen<T>[exponent]
+                           : result / kPowersOfTen<T>[-exponent];
+  }
+  value = negative ? -result : result;
+  return it;
+}
+
+/**
+ * @brief Scans floating point number
+ *
+ * Digit separators are removed before conversion. Everything after
+ * the number is returned as suffix
+ *
+ * @param data Text of the number
+ * @param value Parsed value
+ * @param suffix Rest of the text
+ * @return ErrorCode
+ */
+template <std::floating_point T>
+constexpr ErrorCode ScanFloating(std::string_view data, T &value,
+                                 std::string_view &suffix) noexcept {
+  if (!data.empty() && data[0] == '+') {
+    data.remove_prefix(1);
+  }
+
+  std::array<char, 64> buffer{};
+  std::string_view digits = data;
+  if (data.find_first_of("'_") != std::string_view::npos) {
+    std::size_t size = 0;
+    std::size_t pos = 0;
+    for (; pos < data.size(); ++pos) {
+      const bool between_digits = pos != 0 && pos + 1 < data.size() &&
+                                  DigitValue(data[pos - 1]) < 10 &&
+                                  DigitValue(data[pos + 1]) < 10;
+      if (IsDigitSeparator(data[pos]) && between_digits) {
+        continue;
+      }
+      if (size == buffer.size()) {
+        return ErrorCode::InvalidValue;
+      }
+      buffer[size++] = data[pos];
+    }
+    digits = std::string_view(buffer.data(), size);
+  }
+
+  const char *end = digits.data() + digits.size();
+  const char *ptr = ParseFloatingFast(digits.data(), end, value);
+  if (ptr == nullptr) {
+    if consteval {
+      // Only fast path is available in constant evaluation
+      return ErrorCode::InvalidValue;
+    } else {
+      auto [parsed, ec] = std::from_chars(digits.data(), end, value);
+      if (ec == std::errc::result_out_of_range) {
+        return ErrorCode::OutOfRange;
+      }
+      if (ec != std::errc{}) {
+        return ErrorCode::InvalidValue;
+      }
+      ptr = parsed;
+    }
+  }
+  // Suffix has no separators, so it's the tail of original text
+  const auto suffix_size = static_cast<std::size_t>(end - ptr);
+  suffix = data.substr(data.size() - suffix_size);
+  return ErrorCode::Ok;
+}
+
+/**
+ * @brief Parses floating point number with range check
+ *
+ * Accepts `1.5`, `-2e-3`, `1'000.5`, `1.5G`. In constant evaluation
+ * only numbers taking \ref ParseFloatingFast are accepted
+ *
+ * @param data Text of the number
+ * @param value Parsed value
+ * @return ErrorCode
+ */
+template <std::floating_point T>
+constexpr ErrorCode ParseFloating(std::string_view data, T &value) noexcept {
+  T parsed{};
+  std::string_view rest;
+  if (auto code = ScanFloating(data, parsed, rest); code != ErrorCode::Ok) {
+    return code;
+  }
+  if (!rest.empty()) {
+    const Suffix *suffix = FindSuffix(kSizeSuffixes, rest);
+    if (suffix == nullptr) {
+      return ErrorCode::InvalidValue;
+    }
+    parsed *= static_cast<T>(suffix->num);
+    if (parsed > std::numeric_limits<T>::max() ||
+        parsed < std::numeric_limits<T>::lowest()) {
+      return ErrorCode::OutOfRange;
+    }
+  }
+  value = parsed;
+  return ErrorCode::Ok;
+}
+
+/// Unit of number without suffix, the Period itself
+template <typename Period>
+inline constexpr Suffix kPeriodSuffix{
+    "", Period::num, static_cast<std::uint64_t>(Period::den)};
+
+/**
+ * @brief Parses duration with unit suffix
+ *
+ * Accepts `250ms`, `2h`, `90s`, number without suffix is a count of
+ * Period. Integer durations must be represented exactly, so `1500us`
+ * can't be parsed into std::chrono::milliseconds
+ *
+ * @param data Text of the duration
+ * @param value Parsed duration
+ * @return ErrorCode
+ */
+template <typename Rep, typename Period>
+constexpr ErrorCode ParseDuration(
+    std::string_view data,
+    std::chrono::duration<Rep, Period> &value) noexcept {
+  using Duration = std::chrono::duration<Rep, Period>;
+
+  auto find_unit = [](std::string_view name) -> const Suffix * {
+    return name.empty() ? &kPeriodSuffix<Period>
+                        : FindSuffix(kDurationSuffixes, name);
+  };
+
+  if constexpr (std::floating_point<Rep>) {
+    Rep count{};
+    std::string_view rest;
+    if (auto code = ScanFloating(data, count, rest); code != ErrorCode::Ok) {
+      return code;
+    }
+    const Suffix *unit = find_unit(rest);
+    if (unit == nullptr) {
+      return ErrorCode::InvalidValue;
+    }
+    value = Duration{count * static_cast<Rep>(unit->num) *
+                     static_cast<Rep>(Period::den) /
+                     (static_cast<Rep>(unit->den) *
+                      static_cast<Rep>(Period::num))};
+    return ErrorCode::Ok;
+  } else {
+    ScannedInteger scanned;
+    if (auto code = ScanInteger(data, scanned); code != ErrorCode::Ok) {
+      return code;
+    }
+    const Suffix *unit = find_unit(scanned.suffix);
+    if (unit == nullptr) {
+      return ErrorCode::InvalidValue;
+    }
+    // count * (unit.num / unit.den) / (Period::num / Period::den)
+    std::uint64_t num = unit->num * static_cast<std::uint64_t>(Period::den);
+    std::uint64_t den = unit->den * static_cast<std::uint64_t>(Period::num);
+    const std::uint64_t divisor = std::gcd(num, den);
+    num /= divisor;
+    den /= divisor;
+    if (scanned.magnitude % den != 0) {
+      return ErrorCode::InvalidValue;
+    }
+    std::uint64_t magnitude = scanned.magnitude / den;
+    if (auto code = ApplySuffix(Suffix{"", num}, magnitude);
+        code != ErrorCode::Ok) {
+      return code;
+    }
+    Rep count{};
+    if (auto code = NarrowInteger(scanned.negative, magnitude, count);
+        code != ErrorCode::Ok) {
+      return code;
+    }
+    value = Duration{count};
+    return ErrorCode::Ok;
+  }
+}
+
+}  // namespace optica::details
@@ -2,6 +2,7 @@
 #include <print>
 #include <string>
 
+#include "error.hpp"
 #include "option_builder.hpp"
 #include "token.hpp"
 #include "type_parsers.hpp"
@@ -11,11 +12,22 @@ enum class ResultType {
   Ok,
   False,
 };
-template <typename ValueType>
+template <typename ValueType = void>
 struct ConsumeResult {
   ResultType type;
   std::size_t advance;
   ValueType value;
+  ErrorCode code{ErrorCode::Ok};
+};
+
+/**
+ * @brief Result of consuming values straight into their destination
+ */
+template <>
+struct ConsumeResult<void> {
+  ResultType type;
+  std::size_t advance;
+  ErrorCode code{ErrorCode::Ok};
 };
 
 /**
@@ -69,14 +81,17 @@ struct Option : Properties... {
     return result;
   }
 
-  auto TryConsume(TokenIterator start, TokenIterator end) const {
+  template <std::forward_iterator Iterator>
+  constexpr auto TryConsume(Iterator start, Iterator end) const {
     using ParsedValue = decltype(this->GetValueType());
     using ReturnType = ConsumeResult<ParsedValue>;
 
     auto token_type = (*start).GetTokenType();
 
     if (token_type == Token::TokenType::Word) {
-      throw std::invalid_argument("ERROR: Currently unsupported");
+      return ReturnType{.type = ResultType::False,
+                        .advance = 0,
+                        .code = ErrorCode::UnsupportedToken};
     }
     auto token_name = (*start).GetTokenData();
 
@@ -103,28 +118,204 @@ struct Option : Properties... {
     return ReturnType{.type = ResultType::False, .advance = 0};
   }
 
-  auto Consume(TokenIterator start, TokenIterator end) const {
+  /**
+   * @brief Checks if option is a flag which takes no values
+   *
+   * @return bool
+   */
+  static constexpr bool IsFlag() noexcept {
+    using ParsedValue = decltype(std::declval<Option>().GetValueType());
+    return !HasArityPropertyType<Properties...> &&
+           std::is_same_v<ParsedValue, bool>;
+  }
+
+  /**
+   * @brief Checks if option writes its value into bound variable
+   *
+   * @return bool
+   */
+  static constexpr bool IsBound() noexcept {
+    return HasBindPropertyType<Properties...>;
+  }
+
+  /**
+   * @brief Checks if option must be set
+   *
+   * @return bool
+   */
+  static constexpr bool IsRequired() noexcept {
+    return HasRequiredPeopertyType<Properties...>;
+  }
+
+  /**
+   * @brief Checks if option has default value
+   *
+   * @return bool
+   */
+  static constexpr bool HasDefault() noexcept {
+    return HasDefaultValuePropertyType<Properties...>;
+  }
+
+  /**
+   * @brief Consumes option and its values
+   *
+   * @param start Name token
+   * @param end End of tokens
+   * @return ConsumeResult, on error advance points to erroneous token
+   */
+  template <std::forward_iterator Iterator>
+  constexpr auto Consume(Iterator start, Iterator end) const {
     using ParsedValue = decltype(this->GetValueType());
-    using ReturnType = ConsumeResult<ParsedValue>;
+    ConsumeResult<ParsedValue> result{.type = ResultType::Ok, .advance = 0};
+    auto status = ConsumeInto(start, end, result.value);
+    result.type = status.type;
+    result.advance = status.advance;
+    result.code = status.code;
+    return result;
+  }
 
-    if constexpr (!HasArityPropertyType<Properties...> and
-                  !std::is_same_v<ParsedValue, bool>) {
-      constexpr int tokens_number = 1;
-      auto value = TypeParser<ParsedValue>::ParseValue(*(++start));
-      return ReturnType{.type = ResultType::Ok, .advance = 2, .value = value};
+  /**
+   * @brief Consumes option and decodes its values into destination
+   *
+   * Destination keeps its allocator, so values may live in
+   * caller provided memory
+   *
+   * @param start Name token
+   * @param end End of tokens
+   * @param value Destination of the value
+   * @return ConsumeResult, on error advance points to erroneous token
+   */
+  template <std::forward_iterator Iterator, typename ParsedValue>
+  constexpr ConsumeResult<> ConsumeInto(Iterator start, Iterator end,
+                                        ParsedValue &value) const {
+    if constexpr (IsFlag()) {
+      value = true;
+      return {.type = ResultType::Ok, .advance = 1};
+    } else {
+      return ConsumeValues(nullptr, start, end, value);
     }
-    if constexpr (HasArityPropertyType<Properties...>) {
+  }
+
+  /**
+   * @brief Consumes option whose first value is attached to its short name
+   *
+   * Used for clusters like `-d42`, where `42` is the attached value.
+   * Remaining values are taken from tokens after the short name token
+   *
+   * @param attached Token with attached value
+   * @param start Short name token
+   * @param end End of tokens
+   * @param value Destination of the value
+   * @return ConsumeResult where advance counts short name token
+   */
+  template <std::forward_iterator Iterator, typename ParsedValue>
+  constexpr ConsumeResult<> ConsumeAttachedInto(const Token &attached,
+                                                Iterator start, Iterator end,
+                                                ParsedValue &value) const {
+    return ConsumeValues(&attached, start, end, value);
+  }
+
+ private:
+  template <std::forward_iterator Iterator, typename ParsedValue>
+  constexpr ConsumeResult<> ConsumeValues(const Token *attached,
+                                          Iterator start, Iterator end,
+                                          ParsedValue &value) const {
+    static_assert(
+        std::is_same_v<ParsedValue, decltype(this->GetValueType())>);
+
+    // Values placed after name token are shifted by one
+    const std::size_t shift = attached == nullptr ? 1 : 0;
+    auto fail = [](ErrorCode code, std::size_t advance) {
+      return ConsumeResult<>{
+          .type = ResultType::False, .advance = advance, .code = code};
+    };
+
+    if constexpr (!HasArityPropertyType<Properties...>) {
+      if (std::distance(start, end) < static_cast<std::ptrdiff_t>(1 + shift)) {
+        return fail(ErrorCode::NotEnoughValues, 0);
+      }
+      const Token token = attached != nullptr ? *attached : *std::next(start);
+      // Name is never taken as a value
+      if (token.GetTokenType() != Token::TokenType::Word &&
+          token.GetTokenType() != Token::TokenType::CompoundName) {
+        return fail(ErrorCode::NotEnoughValues, 0);
+      }
+      if (auto code = details::DecodeValue(token, value);
+          code != ErrorCode::Ok) {
+        return fail(code, shift);
+      }
+      if constexpr (HasVariantPropertyType<Properties...>) {
+        using VariantType =
+            typename std::decay_t<decltype(this->GetVariants())>::value_type;
+        static_assert(details::kComparableVariant<ParsedValue, VariantType>,
+                      "Variants of every value of list require arity");
+        if (!this->IsVariant(value)) {
+          return fail(ErrorCode::UnexpectedVariant, shift);
+        }
+      }
+      return {.type = ResultType::Ok, .advance = 1 + shift};
+    } else {
       using ArityType = decltype(this->GetArityType());
-      if constexpr (ExactArity<ArityType>) {
-        constexpr std::size_t size = ArityType::GetNumberArgs();
-        ParsedValue res;
-        for (std::size_t i = 0; i < size; ++i) {
-          res[i] = TypeParser<ParsedValue>::ParseValue(*(++start));
+      constexpr bool kExact = ExactArity<ArityType>;
+      static_assert(kExact || ResizableContainer<ParsedValue>,
+                    "Variable arity requires resizable container");
+      constexpr std::size_t min = [] {
+        if constexpr (kExact) {
+          return ArityType::GetNumberArgs();
+        } else {
+          return ArityType::GetMinArgs();
+        }
+      }();
+      constexpr std::size_t max = [] {
+        if constexpr (kExact) {
+          return ArityType::GetNumberArgs();
+        } else {
+          return ArityType::GetMaxArgs();
+        }
+      }();
+
+      // Value token can't be split between options
+      details::ValueCursor cursor{attached, std::next(start), end};
+      std::size_t size = max;
+      if constexpr (!kExact) {
+        // Values are counted before decoding, so storage is sized once
+        auto counter = cursor;
+        size = 0;
+        for (Token token; size != max && counter.NextToken(token);) {
+          size += details::CountUnits(token);
+          if (size > max) {
+            return fail(ErrorCode::TooManyUnits, counter.GetOffset());
+          }
+        }
+        if (size < min) {
+          return fail(ErrorCode::NotEnoughValues, 0);
         }
-        return ReturnType{
-            .type = ResultType::Ok, .advance = size + 1, .value = res};
+        value.clear();
+        value.resize(size);
       }
-    };
+
+      // Every value is checked against variants as soon as it's decoded
+      auto check = [this](const auto &element) {
+        if constexpr (HasVariantPropertyType<Properties...>) {
+          return this->IsVariant(element);
+        } else {
+          return true;
+        }
+      };
+      std::size_t decoded = 0;
+      ErrorCode code =
+          details::DecodeValues(cursor, value.data(), size, decoded, check);
+      if (code == ErrorCode::Ok && cursor.HasPendingUnits()) {
+        code = ErrorCode::TooManyUnits;
+      }
+      if (code != ErrorCode::Ok) {
+        return fail(code, code == ErrorCode::NotEnoughValues
+                              ? 0
+                              : cursor.GetOffset());
+      }
+      return {.type = ResultType::Ok,
+              .advance = (size == 0 ? 0 : cursor.GetOffset()) + 1};
+    }
   }
 };
 
@@ -1,4 +1,6 @@
 #pragma once
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
 #include "properties.hpp"
@@ -91,16 +93,49 @@ concept HasMatchingDefaultValueType =
     (!HasDefaultValuePropertyType<Properties...>) ||
     (MatchingDefaultAndValueTypes<Properties...>);
 
+namespace details {
+/**
+ * @brief Checks if variant of type Variant can be compared with Value
+ *
+ * String options also accept std::string_view variants
+ */
+template <typename Value, typename Variant>
+constexpr bool kComparableVariant =
+    std::is_same_v<Value, Variant> ||
+    (std::is_same_v<Variant, std::string_view> &&
+     std::is_convertible_v<const Value &, std::string_view>);
+
+/**
+ * @brief Checks if variant can be compared with every value of list
+ *
+ * Values of option with arity are checked one by one
+ */
+template <typename Value, typename Variant>
+constexpr bool kComparableElementVariant = false;
+
+template <typename Value, typename Variant>
+  requires requires { typename Value::value_type; }
+constexpr bool kComparableElementVariant<Value, Variant> =
+    kComparableVariant<typename Value::value_type, Variant>;
+}  // namespace details
+
 /**
  * @concept MatchingVariantAndValueTypes
  * @brief Checks if Holding ValueType and VariantProperty type are same
  *
  */
 template <typename... Properties>
-concept MatchingVariantAndValueTypes = std::is_same_v<
-    decltype(std::declval<OptionBuilder<Properties...>>().GetValueType()),
-    typename std::decay_t<decltype(std::declval<OptionBuilder<Properties...>>()
-                                       .GetVariants())>::value_type>;
+concept MatchingVariantAndValueTypes =
+    details::kComparableVariant<
+        decltype(std::declval<OptionBuilder<Properties...>>().GetValueType()),
+        typename std::decay_t<
+            decltype(std::declval<OptionBuilder<Properties...>>()
+                         .GetVariants())>::value_type> ||
+    details::kComparableElementVariant<
+        decltype(std::declval<OptionBuilder<Properties...>>().GetValueType()),
+        typename std::decay_t<
+            decltype(std::declval<OptionBuilder<Properties...>>()
+                         .GetVariants())>::value_type>;
 
 /**
  * @concept HasMatchingVariantPropertyType
@@ -115,6 +150,10 @@ concept MatchingVariantAndValueTypes = std::is_same_v<
  * // This is invalid because variant type are string literal
  * auto option = optica::Opt<"Day", int> | optica::Variant("Mon", "Tue", "Wed",
  * "Thu", "Fri", "Sat", "Sun");
+ *
+ * // This is valid because string literals are compared with string value
+ * auto option = optica::Opt<"Day", std::string> | optica::Variant("Mon",
+ * "Tuesday");
  * @endcode
  */
 template <typename... Properties>
@@ -122,6 +161,36 @@ concept HasMatchingVariantPropertyType =
     (!HasVariantPropertyType<Properties...>) ||
     (MatchingVariantAndValueTypes<Properties...>);
 
+/**
+ * @concept MatchingBindAndValueTypes
+ * @brief Checks if Holding ValueType and type of bound variable are same
+ *
+ */
+template <typename... Properties>
+concept MatchingBindAndValueTypes = std::is_same_v<
+    decltype(std::declval<OptionBuilder<Properties...>>().GetValueType()),
+    std::decay_t<decltype(std::declval<OptionBuilder<Properties...>>()
+                              .value)>>;
+
+/**
+ * @concept HasMatchingBindPropertyType
+ * @brief Checks if set of Properties has BindProperty and if it has checks
+ * that bound variable has holding ValueType
+ *
+ * @code{.cpp}
+ * int day{};
+ * // This is valid because both option and variable hold int
+ * auto option = optica::Opt<"Day", int>() | optica::Bind(day);
+ *
+ * // This is invalid because option holds double
+ * auto option = optica::Opt<"Day", double>() | optica::Bind(day);
+ * @endcode
+ */
+template <typename... Properties>
+concept HasMatchingBindPropertyType =
+    (!HasBindPropertyType<Properties...>) ||
+    (MatchingBindAndValueTypes<Properties...>);
+
 /**
  * @concept ValidOrderExpression
  * @brief Checks if Option expression starts with Opt
@@ -135,9 +204,11 @@ concept ValidOrderExpression =
  * @brief Cchecks if Property expression is valid
  */
 template <typename... Properties>
-concept ValidPropertyExpression = UniqueProperties<Properties...> &&
-                                  HasMatchingDefaultValueType<Properties...> &&
-                                  HasMatchingVariantPropertyType<Properties...>;
+concept ValidPropertyExpression =
+    UniqueProperties<Properties...> &&
+    HasMatchingDefaultValueType<Properties...> &&
+    HasMatchingVariantPropertyType<Properties...> &&
+    HasMatchingBindPropertyType<Properties...>;
 
 /**
  * @brief Pipe operator for accumulating properties
@@ -221,6 +292,9 @@ constexpr auto ShortName() noexcept {
 /**
  * @brief Sets BindProperty for option
  *
+ * Parsed value is decoded straight into the bound variable and
+ * \ref ParseResult keeps only presence of the option
+ *
  * @tparam ValueType Type of holding bind
  * @param value Value binded
  *
@@ -250,6 +324,53 @@ constexpr auto Bind(ValueType &value) noexcept {
   return OptionBuilder<BindProperty<ValueType>>{BindProperty<ValueType>{value}};
 }
 
+/**
+ * @brief Puts option into group of mutually exclusive options
+ *
+ * @tparam Group Name of the group
+ *
+ * @code{.cpp}
+ * // --json and --yaml can't be met together
+ * auto json = optica::Flag<"json">() | optica::ExclusiveGroup<"format">();
+ * auto yaml = optica::Flag<"yaml">() | optica::ExclusiveGroup<"format">();
+ * @endcode
+ */
+template <FixedString Group>
+constexpr auto ExclusiveGroup() noexcept {
+  return OptionBuilder<ExclusiveGroupProperty<Group>>{};
+}
+
+/**
+ * @brief Sets text of option shown in usage
+ *
+ * @tparam Text Description of the option
+ *
+ * @code{.cpp}
+ * auto threads = optica::Opt<"threads", int>() |
+ *                optica::Description<"Number of worker threads">();
+ * @endcode
+ */
+template <FixedString Text>
+constexpr auto Description() noexcept {
+  return OptionBuilder<DescriptionProperty<Text>>{};
+}
+
+/**
+ * @brief Sets options which must have values when this option is met
+ *
+ * @tparam Names Names of required options
+ *
+ * @code{.cpp}
+ * auto user = optica::Opt<"user", std::string>() |
+ *             optica::Requires<"password">();
+ * @endcode
+ */
+template <FixedString... Names>
+  requires(sizeof...(Names) > 0)
+constexpr auto Requires() noexcept {
+  return OptionBuilder<RequiresProperty<Names...>>{};
+}
+
 /**
  * @brief Sets VariantProperty for option
  *
@@ -257,9 +378,9 @@ constexpr auto Bind(ValueType &value) noexcept {
  * @param vals variants
  */
 template <typename... ValueType>
-  requires SameTypes<ValueType...>
-constexpr auto Variant(ValueType &&...vals) noexcept {
-  using ReturnType = std::common_type_t<ValueType...>;
+  requires SameTypes<std::decay_t<ValueType>...>
+constexpr auto Variant(ValueType &&...vals) {
+  using ReturnType = details::VariantValueType<ValueType...>;
   return OptionBuilder<VariantProperty<ReturnType, sizeof...(ValueType)>>{
       VariantProperty<ReturnType, sizeof...(ValueType)>{
           std::forward<ValueType>(vals)...}};
@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "aggregate.hpp"
+#include "bit_mask.hpp"
+#include "option.hpp"
+
+namespace optica {
+
+template <OptionType... Ts>
+class Parser;
+
+namespace details {
+
+/**
+ * @brief Names of options in order of declaration
+ */
+template <OptionType... Opts>
+inline constexpr std::array<std::string_view, sizeof...(Opts)> kOptionNames = {
+    std::string_view(Opts::GetName())...};
+
+template <FixedString Name, int idx>
+struct EnsureIndexExists {
+  static_assert(idx != -1, "ProgramOption with the given name not found.");
+  static constexpr std::size_t value = idx;
+};
+
+/**
+ * @brief Type of value parsed by option
+ */
+template <OptionType Opt>
+using OptionValueType = decltype(std::declval<Opt>().GetValueType());
+
+/**
+ * @brief Empty slot of option whose value goes into bound variable
+ *
+ * Every option gets its own type, so empty slots share address
+ * and take no space in tuple
+ */
+template <OptionType Opt>
+struct BoundSlot {};
+
+/**
+ * @brief Type stored in result for option
+ */
+template <OptionType Opt>
+using OptionSlotType = std::conditional_t<Opt::IsBound(), BoundSlot<Opt>,
+                                          OptionValueType<Opt>>;
+
+/**
+ * @brief Makes empty value which allocates from resource
+ *
+ * Allocator aware types get polymorphic allocator, arrays pass it to their
+ * elements, other types are value initialized
+ *
+ * @param resource Memory resource
+ * @return T
+ */
+template <typename T>
+T MakeValue(std::pmr::memory_resource *resource) {
+  using Allocator = std::pmr::polymorphic_allocator<>;
+  if constexpr (std::uses_allocator_v<T, Allocator>) {
+    return std::make_obj_using_allocator<T>(Allocator(resource));
+  } else if constexpr (is_std_array<T>::value) {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return T{((void)Is, MakeValue<typename T::value_type>(resource))...};
+    }(std::make_index_sequence<std::tuple_size_v<T>>{});
+  } else {
+    return T{};
+  }
+}
+
+/**
+ * @brief Checks if value type points into parsed input
+ */
+template <typename T>
+struct is_borrowed_value : std::false_type {};
+
+template <>
+struct is_borrowed_value<std::string_view> : std::true_type {};
+
+template <typename T, std::size_t N>
+struct is_borrowed_value<std::array<T, N>> : is_borrowed_value<T> {};
+
+template <ResizableContainer T>
+struct is_borrowed_value<T> : is_borrowed_value<typename T::value_type> {};
+
+template <typename T>
+struct is_borrowed_value<std::optional<T>> : is_borrowed_value<T> {};
+
+template <typename First, typename Second>
+struct is_borrowed_value<std::pair<First, Second>>
+    : std::bool_constant<is_borrowed_value<First>::value ||
+                         is_borrowed_value<Second>::value> {};
+
+template <typename... Ts>
+struct is_borrowed_value<std::tuple<Ts...>>
+    : std::bool_constant<(is_borrowed_value<Ts>::value || ...)> {};
+
+template <typename... Ts>
+struct is_borrowed_value<std::variant<Ts...>>
+    : std::bool_constant<(is_borrowed_value<Ts>::value || ...)> {};
+
+template <DecodableAggregate T>
+struct is_borrowed_value<T>
+    : std::bool_constant<[]<typename... Fields>(std::tuple<Fields &...> *) {
+        return (is_borrowed_value<std::remove_cv_t<Fields>>::value || ...);
+      }(static_cast<decltype(TieFields(std::declval<T &>())) *>(nullptr))> {};
+
+/**
+ * @struct PackedLayout
+ * @brief Places values in order of decreasing alignment
+ *
+ * Sorted values need no padding between them, so storage takes
+ * roughly the sum of value sizes
+ *
+ * @tparam Ts Types of values in order of declaration
+ */
+template <typename... Ts>
+struct PackedLayout {
+  static constexpr std::size_t kSize = sizeof...(Ts);
+
+  /**
+   * @brief Value indexes in order of placement
+   */
+  static constexpr std::array<std::size_t, kSize> kOrder = [] {
+    constexpr std::array<std::size_t, kSize> alignments = {alignof(Ts)...};
+    std::array<std::size_t, kSize> order{};
+    for (std::size_t i = 0; i < kSize; ++i) {
+      order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [&](std::size_t lhs, std::size_t rhs) {
+                if (alignments[lhs] != alignments[rhs]) {
+                  return alignments[lhs] > alignments[rhs];
+                }
+                return lhs < rhs;
+              });
+    return order;
+  }();
+
+  /**
+   * @brief Positions of values in storage by value index
+   */
+  static constexpr std::array<std::size_t, kSize> kSlots = [] {
+    std::array<std::size_t, kSize> slots{};
+    for (std::size_t i = 0; i < kSize; ++i) {
+      slots[kOrder[i]] = i;
+    }
+    return slots;
+  }();
+
+  template <std::size_t... Is>
+  static auto MakeStorage(std::index_sequence<Is...>)
+      -> std::tuple<std::tuple_element_t<kOrder[Is], std::tuple<Ts...>>...>;
+
+  using Storage = decltype(MakeStorage(std::index_sequence_for<Ts...>{}));
+
+  /**
+   * @brief Makes storage whose values allocate from resource
+   *
+   * @param resource Memory resource
+   * @return Storage with empty values
+   */
+  static Storage CreateStorage(std::pmr::memory_resource *resource) {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return Storage{MakeValue<std::tuple_element_t<Is, Storage>>(resource)...};
+    }(std::index_sequence_for<Ts...>{});
+  }
+};
+
+}  // namespace details
+
+/**
+ * @class ParseResult
+ * @brief Values of parsed options
+ *
+ * Presence of all values is kept in a single bitmask and values are
+ * stored without std::optional wrappers, ordered by alignment together
+ * with the mask.
+ * Size of result is reported by \ref kPackedSize
+ *
+ * @code{.cpp}
+ * using Result = decltype(parser)::ParseResultType;
+ * static_assert(Result::kPackedSize <= 16);
+ * @endcode
+ *
+ * @warning If any option holds std::string_view, result borrows the
+ * input (see \ref kBorrowsInput). Such result must not outlive the parsed
+ * string or argv, and parser refuses temporary std::string inputs
+ */
+template <OptionType... Options>
+class ParseResult {
+  // The lower half of mask marks options having value, the upper half
+  // marks options met in input. Single mask is placed with values, so
+  // it may occupy their tail padding
+  using Mask = details::BitMask<2 * sizeof...(Options)>;
+  using Layout =
+      details::PackedLayout<details::OptionSlotType<Options>..., Mask>;
+  static constexpr std::size_t kMaskSlot = Layout::kSlots[sizeof...(Options)];
+  /// Index of the first bit of options met in input
+  static constexpr std::size_t kSeenBit = sizeof...(Options);
+
+ public:
+  /// Size of packed result in bytes
+  static constexpr std::size_t kPackedSize = sizeof(typename Layout::Storage);
+  /// Size of result built from std::optional values
+  static constexpr std::size_t kUnpackedSize =
+      sizeof(std::tuple<std::optional<details::OptionValueType<Options>>...>);
+
+  /// Checks if values point into parsed input
+  static constexpr bool kBorrowsInput =
+      (details::is_borrowed_value<
+           details::OptionValueType<Options>>::value ||
+       ...);
+
+  /// Checks if result is copied as plain bytes
+  static constexpr bool kTriviallyCopyable =
+      (std::is_trivially_copyable_v<details::OptionSlotType<Options>> && ...);
+
+  constexpr ParseResult() = default;
+
+  /**
+   * @brief Constructs empty result
+   *
+   * Allocator aware values like std::pmr::string allocate from resource,
+   * so a monotonic buffer may hold all of them and be released at once
+   *
+   * @param resource Memory resource, must outlive the result
+   */
+  explicit ParseResult(std::pmr::memory_resource *resource)
+      : values_(Layout::CreateStorage(resource)) {}
+
+  /**
+   * @brief Marks all options as not set
+   *
+   * Values themselves are kept, so strings keep their capacity and
+   * the next parse into this result reuses their memory
+   */
+  constexpr void Reset() noexcept {
+    std::get<kMaskSlot>(values_).Clear();
+  }
+
+  /**
+   * @brief Checks if option was set or has default value
+   *
+   * Works for bound options too, whose values aren't stored in result
+   *
+   * @tparam Name Name of the option
+   * @return bool
+   */
+  template <FixedString Name>
+  [[nodiscard]] constexpr bool Contains() const noexcept {
+    return GetMask().Test(GetIndex<Name>());
+  }
+
+  /**
+   * @brief Get value of option
+   *
+   * @tparam Name Name of the option
+   * @return std::optional with value or std::nullopt if option wasn't set
+   */
+  template <FixedString Name>
+  constexpr auto Get() const noexcept {
+    constexpr std::size_t idx = GetIndex<Name>();
+    using ValueType = std::tuple_element_t<idx, std::tuple<Options...>>;
+    static_assert(!ValueType::IsBound(),
+                  "Value of bound option is stored in bound variable, "
+                  "use Contains to check if it was set");
+    if (!GetMask().Test(idx)) {
+      return std::optional<details::OptionValueType<ValueType>>{};
+    }
+    return std::optional<details::OptionValueType<ValueType>>{
+        std::get<Layout::kSlots[idx]>(values_)};
+  }
+
+ private:
+  friend Parser<Options...>;
+
+  template <std::size_t I>
+  [[nodiscard]] constexpr bool HasValue() const noexcept {
+    return GetMask().Test(I);
+  }
+
+  template <std::size_t I>
+  [[nodiscard]] constexpr bool WasSeen() const noexcept {
+    return GetMask().Test(kSeenBit + I);
+  }
+
+  /**
+   * @brief Sets value without marking option as met in input
+   */
+  template <std::size_t I, typename T>
+  constexpr void SetValue(T &&value) {
+    std::get<Layout::kSlots[I]>(values_) = std::forward<T>(value);
+    std::get<kMaskSlot>(values_).Set(I);
+  }
+
+  template <std::size_t I>
+  [[nodiscard]] constexpr auto &GetSlot() noexcept {
+    return std::get<Layout::kSlots[I]>(values_);
+  }
+
+  template <std::size_t I>
+  constexpr void MarkPresent() noexcept {
+    std::get<kMaskSlot>(values_).Set(I);
+    std::get<kMaskSlot>(values_).Set(kSeenBit + I);
+  }
+
+  template <std::size_t I>
+  constexpr void MarkDefault() noexcept {
+    std::get<kMaskSlot>(values_).Set(I);
+  }
+
+  /**
+   * @brief Get mask of options having value followed by options met
+   * in input, see \ref kSeenBit
+   */
+  [[nodiscard]] constexpr const Mask &GetMask() const noexcept {
+    return std::get<kMaskSlot>(values_);
+  }
+
+  template <FixedString Name>
+  static consteval std::size_t GetIndex() {
+    constexpr int idx_raw =
+        GetIndexByName<Name>(std::index_sequence_for<Options...>{});
+    return details::EnsureIndexExists<Name, idx_raw>::value;
+  }
+
+  template <FixedString Name, std::size_t... Is>
+  static consteval int GetIndexByName(std::index_sequence<Is...> idxs) {
+    const auto &names = details::kOptionNames<Options...>;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      if (names[i] == static_cast<std::string_view>(Name)) {
+        return i;
+      }
+    };
+    return -1;
+  }
+
+ private:
+  typename Layout::Storage values_{};
+};
+
+}  // namespace optica
@@ -1,9 +1,21 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <expected>
+#include <memory_resource>
+#include <string>
 #include <tuple>
 
+#include "error.hpp"
 #include "option.hpp"
+#include "parse_result.hpp"
+#include "perfect_hash.hpp"
 #include "token.hpp"
+#include "token_tape.hpp"
+#include "usage.hpp"
 
 namespace optica {
 
@@ -14,15 +26,8 @@ constexpr void ParseByLongName(TokenIterator &it) {
 
 namespace details {
 
-template <OptionType... Opts>
-consteval auto ConstructNamesArray() noexcept {
-  std::array<std::string, sizeof...(Opts)> res = {
-      std::string(Opts::GetName())...};
-  return res;
-}
-
 template <typename T>
-constexpr std::string GetShortNameOrEmpty() {
+constexpr std::string_view GetShortNameOrEmpty() noexcept {
   if constexpr (requires { T::GetShortName(); }) {
     return T::GetShortName();
   } else {
@@ -30,14 +35,43 @@ constexpr std::string GetShortNameOrEmpty() {
   }
 }
 
+/**
+ * @brief Short names of options in order of declaration
+ */
 template <OptionType... Opts>
-constexpr auto ConstructShortNamesArray() {
-  std::array<std::string, sizeof...(Opts)> all = {
-      std::string(GetShortNameOrEmpty<Opts>())...};
+inline constexpr std::array<std::string_view, sizeof...(Opts)> kShortNames = {
+    GetShortNameOrEmpty<Opts>()...};
 
-  return all;
+template <typename T>
+constexpr std::string_view GetExclusiveGroupOrEmpty() noexcept {
+  if constexpr (requires { T::GetExclusiveGroup(); }) {
+    return T::GetExclusiveGroup();
+  } else {
+    return "";
+  }
 }
 
+/**
+ * @brief Exclusive groups of options in order of declaration
+ */
+template <OptionType... Opts>
+inline constexpr std::array<std::string_view, sizeof...(Opts)>
+    kExclusiveGroups = {GetExclusiveGroupOrEmpty<Opts>()...};
+
+template <typename T>
+constexpr bool HasRequiredNames() noexcept {
+  return requires { T::GetRequiredNames(); };
+}
+
+/**
+ * @brief Options which must have values when option is met
+ */
+template <std::size_t N>
+struct Dependency {
+  std::size_t option_index;
+  BitMask<N> required;
+};
+
 template <typename Tuple>
 struct tuple_types;
 
@@ -63,126 +97,868 @@ constexpr auto make_program_option(T &&t) {
   }
 }
 
-template <FixedString Name, int idx>
-struct EnsureIndexExists {
-  static_assert(idx != -1, "ProgramOption with the given name not found.");
-  static constexpr std::size_t value = idx;
-};
+/**
+ * @brief Placeholder of prototype for results which aren't trivially copyable
+ */
+struct NoPrototype {};
 
 }  // namespace details
 
-template <OptionType... Ts>
-class Parser;
-
 template <OptionType... Options>
-class ParseResult {
-  using ValueType = std::tuple<
-      std::optional<decltype(std::declval<Options>().GetValueType())>...>;
-
+class Parser {
  public:
-  constexpr ParseResult() = default;
+  using OptionsValue = std::tuple<Options...>;
+  using ParseResultType = ParseResult<Options...>;
 
-  template <FixedString Name>
-  constexpr auto Get() const noexcept {
-    constexpr int idx_raw =
-        GetIndexByName<Name>(std::index_sequence_for<Options...>{});
-    constexpr int idx = details::EnsureIndexExists<Name, idx_raw>::value;
-    return std::get<idx>(values_);
+  template <typename... Args>
+  constexpr Parser(Args &&...opts) noexcept
+      : options_(details::make_program_option(std::forward<Args>(opts))...),
+        prototype_(MakePrototype()) {}
+
+  /**
+   * @brief Parses sequence of chars
+   *
+   * @param data std::string_view with command line
+   * @param resource Memory resource for allocator aware values,
+   * nullptr means the default one
+   * @return ParseResultType parsed values
+   * @throws std::invalid_argument if input is malformed
+   */
+  constexpr ParseResultType Parse(
+      std::string_view data,
+      std::pmr::memory_resource *resource = nullptr) const {
+    return Parse(TokenTape{data}, resource);
   }
 
- private:
-  friend Parser<Options...>;
+  /**
+   * @brief Rejects temporary strings when result borrows input
+   *
+   * std::string_view values would dangle right after the call
+   */
+  template <typename String, typename... Args>
+    requires(ParseResultType::kBorrowsInput &&
+             std::same_as<String, std::string>)
+  ParseResultType Parse(String &&data, Args &&...args) const = delete;
+
+  /**
+   * @brief Parses program arguments
+   *
+   * Arguments are tokenized in place without joining them into one string
+   *
+   * @param argc Number of arguments
+   * @param argv Arguments, the first one is program name
+   * @param resource Memory resource for allocator aware values,
+   * nullptr means the default one
+   * @return ParseResultType parsed values
+   * @throws std::invalid_argument if input is malformed
+   *
+   * @remark Arguments go into a temporary \ref TokenTape, which allocates
+   * on every call. Parse a reused tape to avoid allocations
+   */
+  constexpr ParseResultType Parse(
+      int argc, const char *const *argv,
+      std::pmr::memory_resource *resource = nullptr) const {
+    return Parse(TokenTape{argc, argv}, resource);
+  }
 
-  template <std::size_t I, typename T>
-  constexpr void SetValue(T &&value) {
-    if (!std::get<I>(values_).has_value()) {
-      std::get<I>(values_) = std::forward<T>(value);
-      return;
+  /**
+   * @brief Parses already tokenized input
+   *
+   * @param tape \ref TokenTape built from the input
+   * @param resource Memory resource for allocator aware values,
+   * nullptr means the default one
+   * @return ParseResultType parsed values
+   * @throws std::invalid_argument if input is malformed
+   *
+   * @remark Tape may be reused across calls to avoid allocations
+   */
+  constexpr ParseResultType Parse(
+      const TokenTape &tape,
+      std::pmr::memory_resource *resource = nullptr) const {
+    ParseResultType result = MakeResult(resource);
+    ParseInto(result, tape);
+    return result;
+  }
+
+  /**
+   * @brief Parses sequence of chars without throwing
+   *
+   * @param data std::string_view with command line
+   * @param resource Memory resource for allocator aware values,
+   * nullptr means the default one
+   * @return std::expected with parsed values or \ref ParseError
+   */
+  constexpr std::expected<ParseResultType, ParseError> TryParse(
+      std::string_view data,
+      std::pmr::memory_resource *resource = nullptr) const {
+    return TryParse(TokenTape{data}, resource);
+  }
+
+  template <typename String, typename... Args>
+    requires(ParseResultType::kBorrowsInput &&
+             std::same_as<String, std::string>)
+  std::expected<ParseResultType, ParseError> TryParse(String &&data,
+                                                      Args &&...args) const =
+      delete;
+
+  /**
+   * @brief Parses program arguments without throwing
+   *
+   * @param argc Number of arguments
+   * @param argv Arguments, the first one is program name
+   * @param resource Memory resource for allocator aware values,
+   * nullptr means the default one
+   * @return std::expected with parsed values or \ref ParseError
+   *
+   * @remark Arguments go into a temporary \ref TokenTape, which allocates
+   * on every call. Parse a reused tape to avoid allocations
+   */
+  constexpr std::expected<ParseResultType, ParseError> TryParse(
+      int argc, const char *const *argv,
+      std::pmr::memory_resource *resource = nullptr) const {
+    return TryParse(TokenTape{argc, argv}, resource);
+  }
+
+  /**
+   * @brief Parses already tokenized input without throwing
+   *
+   * Errors are reported as plain values, no message is built
+   * until \ref FormatError is called
+   *
+   * Allocator aware values like std::pmr::string are allocated from
+   * resource. With reused tape and monotonic buffer parsing makes no
+   * global allocations:
+   *
+   * @code{.cpp}
+   * std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer)};
+   * for (auto command : commands) {
+   *   tape.Build(command);
+   *   auto result = parser.TryParse(tape, &arena);
+   *   // ...
+   *   arena.release();
+   * }
+   * @endcode
+   *
+   * @param tape \ref TokenTape built from the input
+   * @param resource Memory resource for allocator aware values,
+   * nullptr means the default one
+   * @return std::expected with parsed values or \ref ParseError
+   */
+  constexpr std::expected<ParseResultType, ParseError> TryParse(
+      const TokenTape &tape,
+      std::pmr::memory_resource *resource = nullptr) const {
+    ParseResultType result = MakeResult(resource);
+    if (auto parsed = TryParseInto(result, tape); !parsed) {
+      return std::unexpected(parsed.error());
     }
-    throw std::invalid_argument("Duplicate option def");
+    return result;
   }
 
-  template <FixedString Name, std::size_t... Is>
-  static consteval int GetIndexByName(std::index_sequence<Is...> idxs) {
-    auto names = details::ConstructNamesArray<Options...>();
-    for (std::size_t i = 0; i < names.size(); ++i) {
-      if (names[i] == static_cast<std::string_view>(Name)) {
-        return i;
+  /**
+   * @brief Parses sequence of chars into existing result
+   *
+   * @param result Result to fill, it's reset before parsing
+   * @param data std::string_view with command line
+   * @throws std::invalid_argument if input is malformed
+   */
+  constexpr void ParseInto(ParseResultType &result,
+                           std::string_view data) const {
+    ParseInto(result, TokenTape{data});
+  }
+
+  template <typename String>
+    requires(ParseResultType::kBorrowsInput &&
+             std::same_as<String, std::string>)
+  void ParseInto(ParseResultType &result, String &&data) const = delete;
+
+  /**
+   * @brief Parses program arguments into existing result
+   *
+   * @param result Result to fill, it's reset before parsing
+   * @param argc Number of arguments
+   * @param argv Arguments, the first one is program name
+   * @throws std::invalid_argument if input is malformed
+   *
+   * @remark Arguments go into a temporary \ref TokenTape, which allocates
+   * on every call. Parse a reused tape to avoid allocations
+   */
+  constexpr void ParseInto(ParseResultType &result, int argc,
+                           const char *const *argv) const {
+    ParseInto(result, TokenTape{argc, argv});
+  }
+
+  /**
+   * @brief Parses already tokenized input into existing result
+   *
+   * @param result Result to fill, it's reset before parsing
+   * @param tape \ref TokenTape built from the input
+   * @throws std::invalid_argument if input is malformed
+   */
+  constexpr void ParseInto(ParseResultType &result,
+                           const TokenTape &tape) const {
+    if (auto parsed = TryParseInto(result, tape); !parsed) {
+      if consteval {
+        // Message can't be formatted in compile time, so malformed
+        // preset fails the build with error code only
+        details::ThrowInvalidArgument(
+            std::string(to_string(parsed.error().code)));
+      } else {
+        details::ThrowInvalidArgument(FormatError(parsed.error(), result));
       }
-    };
-    return -1;
+    }
   }
 
- private:
-  ValueType values_;
-};
+  /**
+   * @brief Parses sequence of chars into existing result without throwing
+   *
+   * @param result Result to fill, it's reset before parsing
+   * @param data std::string_view with command line
+   * @return std::expected empty or with \ref ParseError
+   */
+  constexpr std::expected<void, ParseError> TryParseInto(
+      ParseResultType &result, std::string_view data) const {
+    return TryParseInto(result, TokenTape{data});
+  }
 
-template <OptionType... Options>
-class Parser {
- public:
-  using OptionsValue = std::tuple<Options...>;
-  using ParseResultType = ParseResult<Options...>;
+  template <typename String>
+    requires(ParseResultType::kBorrowsInput &&
+             std::same_as<String, std::string>)
+  std::expected<void, ParseError> TryParseInto(ParseResultType &result,
+                                               String &&data) const = delete;
+
+  /**
+   * @brief Parses program arguments into existing result without throwing
+   *
+   * @param result Result to fill, it's reset before parsing
+   * @param argc Number of arguments
+   * @param argv Arguments, the first one is program name
+   * @return std::expected empty or with \ref ParseError
+   *
+   * @remark Arguments go into a temporary \ref TokenTape, which allocates
+   * on every call. Parse a reused tape to avoid allocations
+   */
+  constexpr std::expected<void, ParseError> TryParseInto(
+      ParseResultType &result, int argc, const char *const *argv) const {
+    return TryParseInto(result, TokenTape{argc, argv});
+  }
 
-  template <typename... Args>
-  constexpr Parser(Args &&...opts) noexcept
-      : options_(details::make_program_option(std::forward<Args>(opts))...) {}
-
-  ParseResultType Parse(std::string_view data) const {
-    ParseResultType result{};
-    auto tokenizer = Tokenizer{data};
-    auto begin = tokenizer.begin();
-    auto end = tokenizer.end();
-
-    constexpr auto size_of_params = sizeof...(Options);
-    std::size_t parsed{};
-
-    for (; begin != end;) {
-      int steps_count{0};
-
-      auto traverse_options = [&]<std::size_t... Is>(
-                                  std::index_sequence<Is...>) {
-        bool was_matched =
-            (([&] {
-               auto consume_result =
-                   std::get<Is>(options_).TryConsume(begin, end);
-               if (consume_result.type == ResultType::Ok) {
-                 if (std::get<Is>(result.values_).has_value()) {
-                   std::string message;
-                   std::format_to(
-                       std::back_inserter(message),
-                       "ERROR: You're trying set option {} more than 1 time",
-                       *begin);
-                   throw std::invalid_argument(message);
-                 }
-                 std::get<Is>(result.values_) = std::move(consume_result.value);
-                 steps_count = consume_result.advance;
-                 ++parsed;
-                 return true;
-               }
-               return false;
-             }()) ||
-             ...);
-
-        if (!was_matched) {
-          std::string message;
-          std::format_to(std::back_inserter(message),
-                         "ERROR: Unknown Argument: {}", *begin);
-          throw std::invalid_argument(message);
+  /**
+   * @brief Parses already tokenized input into existing result without
+   * throwing
+   *
+   * Result is reset to default values first. Trivially copyable result
+   * is just copied from prototype built in compile time. Otherwise values
+   * keep their memory, so strings of the same or smaller size are
+   * assigned without allocations. Reusing both
+   * tape and result makes steady state parsing allocation free:
+   *
+   * @code{.cpp}
+   * decltype(parser)::ParseResultType result;
+   * for (auto command : commands) {
+   *   tape.Build(command);
+   *   if (parser.TryParseInto(result, tape)) {
+   *     // ...
+   *   }
+   * }
+   * @endcode
+   *
+   * @param result Result to fill, it holds partial values on error
+   * @param tape \ref TokenTape built from the input
+   * @return std::expected empty or with \ref ParseError
+   *
+   * @warning Memory resource of result must outlive it, so don't release
+   * an arena while result built from it is still reused
+   */
+  constexpr std::expected<void, ParseError> TryParseInto(
+      ParseResultType &result, const TokenTape &tape) const {
+    if constexpr (ParseResultType::kTriviallyCopyable) {
+      result = prototype_;
+    } else {
+      result.Reset();
+    }
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (ApplyDefault<Is>(result), ...);
+    }(std::index_sequence_for<Options...>{});
+
+    auto begin = tape.begin();
+    auto end = tape.end();
+
+    while (begin != end) {
+      const Token token = *begin;
+      Consumed consumed;
+
+      switch (token.GetTokenType()) {
+        case Token::TokenType::LongName: {
+          const std::size_t index = FindByLongName(token.GetTokenData());
+          if (index == kNotFound) {
+            consumed = Fail(ErrorCode::UnknownArgument, kNotFound, token);
+            break;
+          }
+          consumed = (this->*kHandlers[index])(begin, end, result);
+          break;
         }
-      };
-      traverse_options(std::make_index_sequence<size_of_params>{});
-      std::advance(begin, steps_count);
+        case Token::TokenType::ShortName:
+          consumed = ConsumeShortNames(begin, end, result);
+          break;
+        default:
+          consumed = Fail(ErrorCode::UnsupportedToken, kNotFound, token);
+      }
+
+      if (!consumed) {
+        const auto &failure = consumed.error();
+        return std::unexpected(ParseError{
+            .code = failure.code,
+            .option_index = failure.option_index == kNotFound
+                                ? ParseError::kNoOption
+                                : static_cast<std::uint32_t>(
+                                      failure.option_index),
+            .offset = static_cast<std::uint32_t>(
+                tape.GetOffset(failure.position))});
+      }
+      begin += *consumed;
+    }
+
+    if (auto error = Validate(result); error.code != ErrorCode::Ok)
+        [[unlikely]] {
+      error.offset = static_cast<std::uint32_t>(tape.GetInputSize());
+      return std::unexpected(error);
+    }
+    return {};
+  }
+
+  /**
+   * @brief Builds human readable message for error
+   *
+   * @param error Error returned by \ref TryParse
+   * @return std::string message
+   */
+  static std::string FormatError(const ParseError &error) {
+    std::string message;
+    std::format_to(std::back_inserter(message), "ERROR: {}",
+                   to_string(error.code));
+    if (error.option_index < sizeof...(Options)) {
+      std::format_to(std::back_inserter(message), " (option --{})",
+                     details::kOptionNames<Options...>[error.option_index]);
+    }
+    std::format_to(std::back_inserter(message), " at offset {}",
+                   error.offset);
+    return message;
+  }
 
-      if (parsed >= size_of_params) {
+  /**
+   * @brief Builds human readable message for error with names of
+   * all missing or conflicting options
+   *
+   * @param error Error returned by \ref TryParseInto
+   * @param result Result passed to \ref TryParseInto
+   * @return std::string message
+   */
+  static std::string FormatError(const ParseError &error,
+                                 const ParseResultType &result) {
+    std::string message = FormatError(error);
+    Mask names;
+    switch (error.code) {
+      case ErrorCode::MissingRequired:
+        names = kRequired;
+        names.Remove(result.GetMask());
+        break;
+      case ErrorCode::ExclusiveOptions:
+        for (const Mask &group : kExclusive) {
+          if (group.Test(kSeen + error.option_index)) {
+            names = group & result.GetMask();
+          }
+        }
         break;
+      case ErrorCode::MissingDependency:
+        for (const auto &dependency : kDependencies) {
+          if (dependency.option_index == error.option_index) {
+            names = dependency.required;
+            names.Remove(result.GetMask());
+          }
+        }
+        break;
+      default:
+        return message;
+    }
+    const char *separator = ": ";
+    for (std::size_t i = 0; i < sizeof...(Options); ++i) {
+      if (names.Test(i) || names.Test(kSeen + i)) {
+        std::format_to(std::back_inserter(message), "{}--{}", separator,
+                       details::kOptionNames<Options...>[i]);
+        separator = ", ";
       }
-      // NOTE: Check for required stuff
     }
-    return result;
+    return message;
+  }
+
+  /**
+   * @brief Get usage text of options
+   *
+   * Text is aligned and wrapped in compile time and kept in read only
+   * data, so printing help needs no formatting or allocations:
+   *
+   * @code{.cpp}
+   * constexpr auto usage = decltype(parser)::GetUsage();
+   * std::fwrite(usage.data(), 1, usage.size(), stdout);
+   * @endcode
+   *
+   * @return std::string_view usage text
+   */
+  static constexpr std::string_view GetUsage() noexcept {
+    return details::kUsage<Options...>;
+  }
+
+ private:
+  static constexpr std::size_t kNotFound = sizeof...(Options);
+
+  /// Index of the first bit of options met in input
+  static constexpr std::size_t kSeen = sizeof...(Options);
+
+  /**
+   * @brief Mask laid out as mask of result, option values in the lower
+   * half and options met in input in the upper one
+   */
+  using Mask = details::BitMask<2 * sizeof...(Options)>;
+
+  /**
+   * @brief Mask of required options
+   */
+  static constexpr Mask kRequired =
+      []<std::size_t... Is>(std::index_sequence<Is...>) {
+        Mask mask;
+        ((Options::IsRequired() ? mask.Set(Is) : void()), ...);
+        return mask;
+      }(std::index_sequence_for<Options...>{});
+
+  static constexpr std::size_t kExclusiveCount = [] {
+    const auto &groups = details::kExclusiveGroups<Options...>;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+      if (!groups[i].empty() &&
+          std::find(groups.begin(), groups.begin() + i, groups[i]) ==
+              groups.begin() + i) {
+        ++count;
+      }
+    }
+    return count;
+  }();
+
+  /**
+   * @brief Masks of mutually exclusive groups
+   */
+  static constexpr std::array<Mask, kExclusiveCount> kExclusive = [] {
+    const auto &groups = details::kExclusiveGroups<Options...>;
+    std::array<Mask, kExclusiveCount> masks{};
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+      auto first = std::find(groups.begin(), groups.begin() + i, groups[i]);
+      if (groups[i].empty() || first != groups.begin() + i) {
+        continue;
+      }
+      for (std::size_t j = i; j < groups.size(); ++j) {
+        if (groups[j] == groups[i]) {
+          masks[count].Set(kSeen + j);
+        }
+      }
+      ++count;
+    }
+    return masks;
+  }();
+
+  /**
+   * @brief Options of any exclusive group, conflict needs two of them
+   */
+  static constexpr Mask kGrouped = [] {
+    const auto &groups = details::kExclusiveGroups<Options...>;
+    Mask mask;
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+      if (!groups[i].empty()) {
+        mask.Set(kSeen + i);
+      }
+    }
+    return mask;
+  }();
+
+  static constexpr std::size_t kDependencyCount =
+      (0 + ... + details::HasRequiredNames<Options>());
+
+  /**
+   * @brief Options required by other options
+   */
+  static constexpr std::array<details::Dependency<2 * sizeof...(Options)>,
+                              kDependencyCount>
+      kDependencies = [] {
+        std::array<details::Dependency<2 * sizeof...(Options)>,
+                   kDependencyCount>
+            dependencies{};
+        std::size_t count = 0;
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+          (
+              [&] {
+                using OptionType = std::tuple_element_t<Is, OptionsValue>;
+                if constexpr (details::HasRequiredNames<OptionType>()) {
+                  auto &dependency = dependencies[count++];
+                  dependency.option_index = Is;
+                  for (auto name : OptionType::GetRequiredNames()) {
+                    const auto &names = details::kOptionNames<Options...>;
+                    auto it = std::find(names.begin(), names.end(), name);
+                    if (it == names.end()) {
+                      details::ThrowInvalidArgument(
+                          "ERROR: Required option not found");
+                    }
+                    dependency.required.Set(
+                        static_cast<std::size_t>(it - names.begin()));
+                  }
+                }
+              }(),
+              ...);
+        }(std::index_sequence_for<Options...>{});
+        return dependencies;
+      }();
+
+  /**
+   * @brief Options having dependencies
+   */
+  static constexpr Mask kDependent = [] {
+    Mask mask;
+    for (const auto &dependency : kDependencies) {
+      mask.Set(kSeen + dependency.option_index);
+    }
+    return mask;
+  }();
+
+  /**
+   * @brief Options required by any option
+   */
+  static constexpr Mask kDependencyTargets = [] {
+    Mask mask;
+    for (const auto &dependency : kDependencies) {
+      for (std::size_t i = 0; i < sizeof...(Options); ++i) {
+        if (dependency.required.Test(i)) {
+          mask.Set(i);
+        }
+      }
+    }
+    return mask;
+  }();
+
+  /**
+   * @brief Checks required options, exclusive groups and dependencies
+   *
+   * Each check is a compare of precomputed masks with the mask of result
+   * regardless of number of groups and dependencies. Groups and
+   * dependencies are walked one by one only to find the failed one
+   *
+   * @return ParseError with ErrorCode::Ok if result is valid
+   */
+  static constexpr ParseError Validate(const ParseResultType &result) noexcept {
+    const Mask &mask = result.GetMask();
+    if (!mask.Contains(kRequired)) [[unlikely]] {
+      Mask missing = kRequired;
+      return MakeError(ErrorCode::MissingRequired,
+                       missing.Remove(mask).FindFirst());
+    }
+    if ((kGrouped & mask).Count() > 1) [[unlikely]] {
+      for (const Mask &group : kExclusive) {
+        Mask met = group & mask;
+        if (met.Count() > 1) {
+          met.Reset(met.FindFirst());
+          return MakeError(ErrorCode::ExclusiveOptions,
+                           met.FindFirst() - kSeen);
+        }
+      }
+    }
+    if (!(kDependent & mask).None() && !mask.Contains(kDependencyTargets))
+        [[unlikely]] {
+      for (const auto &dependency : kDependencies) {
+        if (mask.Test(kSeen + dependency.option_index) &&
+            !mask.Contains(dependency.required)) {
+          return MakeError(ErrorCode::MissingDependency,
+                           dependency.option_index);
+        }
+      }
+    }
+    return {};
+  }
+
+  static constexpr ParseError MakeError(ErrorCode code,
+                                        std::size_t option_index) noexcept {
+    return ParseError{.code = code,
+                      .option_index =
+                          static_cast<std::uint32_t>(option_index)};
+  }
+
+  /**
+   * @brief Error found while consuming tokens
+   */
+  struct Failure {
+    ErrorCode code;
+    std::size_t option_index;
+    const char *position;
+  };
+
+  /**
+   * @brief Number of consumed tokens or error
+   */
+  using Consumed = std::expected<std::size_t, Failure>;
+
+  using Handler = Consumed (Parser::*)(TokenTapeIterator, TokenTapeIterator,
+                                       ParseResultType &) const;
+
+  static constexpr std::unexpected<Failure> Fail(ErrorCode code,
+                                                 std::size_t option_index,
+                                                 const Token &token) noexcept {
+    return std::unexpected(
+        Failure{code, option_index, token.GetTokenData().data()});
+  }
+
+  /**
+   * @brief Makes empty result, values of null resource use default one
+   */
+  static constexpr ParseResultType MakeResult(
+      std::pmr::memory_resource *resource) {
+    if (resource == nullptr) {
+      return ParseResultType{};
+    }
+    return ParseResultType{resource};
+  }
+
+  using Prototype =
+      std::conditional_t<ParseResultType::kTriviallyCopyable, ParseResultType,
+                         details::NoPrototype>;
+
+  /**
+   * @brief Builds result holding all default values
+   *
+   * Defaults of bound options are only marked, variables get them
+   * on every parse
+   */
+  constexpr Prototype MakePrototype() const {
+    Prototype prototype{};
+    if constexpr (ParseResultType::kTriviallyCopyable) {
+      [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        (
+            [&] {
+              using OptionType = std::tuple_element_t<Is, OptionsValue>;
+              if constexpr (OptionType::HasDefault()) {
+                if constexpr (OptionType::IsBound()) {
+                  prototype.template MarkDefault<Is>();
+                } else {
+                  prototype.template SetValue<Is>(
+                      std::get<Is>(options_).GetDefaultValue());
+                }
+              }
+            }(),
+            ...);
+      }(std::index_sequence_for<Options...>{});
+    }
+    return prototype;
+  }
+
+  /**
+   * @brief Applies default value of I-th option which isn't in prototype
+   */
+  template <std::size_t I>
+  constexpr void ApplyDefault(ParseResultType &result) const {
+    using OptionType = std::tuple_element_t<I, OptionsValue>;
+    if constexpr (!OptionType::HasDefault()) {
+      return;
+    } else if constexpr (!ParseResultType::kTriviallyCopyable) {
+      GetDestination<I>(result) = std::get<I>(options_).GetDefaultValue();
+      result.template MarkDefault<I>();
+    } else if constexpr (OptionType::IsBound()) {
+      std::get<I>(options_).value = std::get<I>(options_).GetDefaultValue();
+    }
+  }
+
+  /**
+   * @brief Place where value of I-th option is decoded
+   *
+   * Bound options are decoded right into their variable,
+   * others into slot of result
+   */
+  template <std::size_t I>
+  constexpr auto &GetDestination(ParseResultType &result) const noexcept {
+    if constexpr (std::tuple_element_t<I, OptionsValue>::IsBound()) {
+      return std::get<I>(options_).value;
+    } else {
+      return result.template GetSlot<I>();
+    }
+  }
+
+  /**
+   * @brief Consumes values of I-th option and stores them into result
+   * or bound variable
+   *
+   * @return Consumed number of consumed tokens
+   */
+  template <std::size_t I>
+  constexpr Consumed ConsumeOption(TokenTapeIterator begin,
+                                   TokenTapeIterator end,
+                                   ParseResultType &result) const {
+    if (result.template WasSeen<I>()) {
+      return Fail(ErrorCode::DuplicateOption, I, *begin);
+    }
+    auto consume_result = std::get<I>(options_).ConsumeInto(
+        begin, end, GetDestination<I>(result));
+    if (consume_result.code != ErrorCode::Ok) {
+      return Fail(consume_result.code, I,
+                  begin[static_cast<std::ptrdiff_t>(consume_result.advance)]);
+    }
+    result.template MarkPresent<I>();
+    return consume_result.advance;
+  }
+
+  /**
+   * @brief Consumes I-th option met inside cluster of short names
+   *
+   * Flags are set right away and cluster goes on. Option with values ends
+   * cluster, the rest of the cluster becomes its first value
+   *
+   * @param attached Rest of the cluster after short name
+   * @return Consumed number of consumed tokens or 0 if cluster goes on
+   */
+  template <std::size_t I>
+  constexpr Consumed ConsumeShortOption(std::string_view attached,
+                                        TokenTapeIterator begin,
+                                        TokenTapeIterator end,
+                                        ParseResultType &result) const {
+    using OptionType = std::tuple_element_t<I, OptionsValue>;
+    if constexpr (OptionType::IsFlag()) {
+      if (result.template WasSeen<I>()) {
+        return std::unexpected(Failure{ErrorCode::DuplicateOption, I,
+                                       attached.data() - 1});
+      }
+      GetDestination<I>(result) = true;
+      result.template MarkPresent<I>();
+      return 0;
+    } else {
+      if (attached.empty()) {
+        return ConsumeOption<I>(begin, end, result);
+      }
+      if (result.template WasSeen<I>()) {
+        return Fail(ErrorCode::DuplicateOption, I, *begin);
+      }
+      const Token value{attached, Token::TokenType::Word};
+      auto consume_result = std::get<I>(options_).ConsumeAttachedInto(
+          value, begin, end, GetDestination<I>(result));
+      if (consume_result.code != ErrorCode::Ok) {
+        return Fail(consume_result.code, I,
+                    consume_result.advance == 0
+                        ? value
+                        : begin[static_cast<std::ptrdiff_t>(
+                              consume_result.advance)]);
+      }
+      result.template MarkPresent<I>();
+      return consume_result.advance;
+    }
+  }
+
+  /**
+   * @brief Consumes cluster of short names like `-abc` or `-d42`
+   *
+   * Every symbol of the cluster is dispatched through \ref kShortIndex,
+   * so cluster is handled in a single pass without building tokens
+   *
+   * @return Consumed number of consumed tokens
+   */
+  constexpr Consumed ConsumeShortNames(TokenTapeIterator begin,
+                                       TokenTapeIterator end,
+                                       ParseResultType &result) const {
+    const Token token = *begin;
+    const std::string_view cluster = token.GetTokenData();
+    if (cluster.empty()) {
+      return Fail(ErrorCode::UnknownArgument, kNotFound, token);
+    }
+    for (std::size_t i = 0; i < cluster.size(); ++i) {
+      const std::size_t index =
+          kShortIndex[static_cast<unsigned char>(cluster[i])];
+      if (index == kNotFound) {
+        return std::unexpected(Failure{ErrorCode::UnknownArgument, kNotFound,
+                                       cluster.data() + i});
+      }
+      auto consumed = (this->*kShortHandlers[index])(cluster.substr(i + 1),
+                                                     begin, end, result);
+      if (!consumed || *consumed != 0) {
+        return consumed;
+      }
+    }
+    return 1;
+  }
+
+  /**
+   * @brief Jump table from option index to its consumer
+   */
+  static constexpr std::array<Handler, sizeof...(Options)> kHandlers =
+      []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return std::array<Handler, sizeof...(Options)>{
+            &Parser::ConsumeOption<Is>...};
+      }(std::index_sequence_for<Options...>{});
+
+  using ShortHandler = Consumed (Parser::*)(std::string_view,
+                                            TokenTapeIterator,
+                                            TokenTapeIterator,
+                                            ParseResultType &) const;
+
+  /**
+   * @brief Jump table from option index to its consumer inside cluster
+   */
+  static constexpr std::array<ShortHandler, sizeof...(Options)>
+      kShortHandlers = []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return std::array<ShortHandler, sizeof...(Options)>{
+            &Parser::ConsumeShortOption<Is>...};
+      }(std::index_sequence_for<Options...>{});
+
+  /**
+   * @brief Table from short name symbol to option index
+   *
+   * Every byte has its own slot, so lookup is a single array read.
+   * Short names must be single symbols and must not repeat. Digits are
+   * reserved for negative numbers
+   */
+  static constexpr std::array<std::uint16_t, 256> kShortIndex = [] {
+    static_assert(sizeof...(Options) < 0xFFFF, "Too many options");
+    std::array<std::uint16_t, 256> table{};
+    table.fill(kNotFound);
+    const auto &names = details::kShortNames<Options...>;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      if (names[i].empty()) {
+        continue;
+      }
+      if (names[i].size() != 1) {
+        details::ThrowInvalidArgument("ERROR: Short name must be one symbol");
+      }
+      if (names[i].front() >= '0' && names[i].front() <= '9') {
+        details::ThrowInvalidArgument("ERROR: Short name can't be a digit");
+      }
+      auto &slot = table[static_cast<unsigned char>(names[i].front())];
+      if (slot != kNotFound) {
+        details::ThrowInvalidArgument("ERROR: Short names aren't unique");
+      }
+      slot = static_cast<std::uint16_t>(i);
+    }
+    return table;
+  }();
+
+  /**
+   * @brief Perfect hash of long names built in compile time
+   */
+  static constexpr details::PerfectHash<sizeof...(Options)> kLongNames{
+      std::array<std::uint64_t, sizeof...(Options)>{
+          details::HashString(Options::GetName())...}};
+
+  static constexpr std::size_t FindByLongName(std::string_view name) noexcept {
+    const std::size_t index = kLongNames.Find(details::HashString(name));
+    if (index == kNotFound ||
+        details::kOptionNames<Options...>[index] != name) {
+      return kNotFound;
+    }
+    return index;
   }
 
  private:
   OptionsValue options_;
+  Prototype prototype_;
 };
 
 template <typename... Args>
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#include "error.hpp"
+
+namespace optica::details {
+
+/**
+ * @brief Hashes string with FNV-1a
+ *
+ * @param data Hashed string
+ * @return std::uint64_t hash value
+ */
+constexpr std::uint64_t HashString(std::string_view data) noexcept {
+  std::uint64_t hash = 0xCBF29CE484222325ULL;
+  for (char symbol : data) {
+    hash ^= static_cast<unsigned char>(symbol);
+    hash *= 0x100000001B3ULL;
+  }
+  return hash;
+}
+
+/**
+ * @brief Mixes key hash with seed
+ *
+ * @param hash Key hash
+ * @param seed Seed
+ * @return std::uint64_t mixed value
+ */
+constexpr std::uint64_t MixHash(std::uint64_t hash,
+                                std::uint64_t seed) noexcept {
+  hash ^= seed * 0x9E3779B97F4A7C15ULL;
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDULL;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+/**
+ * @class PerfectHash
+ * @brief Collision free hash table of N keys built in compile time
+ *
+ * Table uses hash and displace scheme. Keys are distributed into buckets by
+ * the first hash, then every bucket gets its own seed that places all its
+ * keys into free slots. Lookup costs two hash mixes and two array reads.
+ *
+ * Table only maps key hash to index of the key, so caller must compare found
+ * key with the looked up one.
+ *
+ * @tparam N Number of keys
+ */
+template <std::size_t N>
+class PerfectHash {
+ public:
+  using IndexType =
+      std::conditional_t<(N < std::numeric_limits<std::uint16_t>::max()),
+                         std::uint16_t, std::uint32_t>;
+
+  static constexpr std::size_t kNotFound = N;
+  static constexpr std::size_t kBuckets = std::bit_ceil(N == 0 ? 1 : N);
+  static constexpr std::size_t kSlots = kBuckets * 2;
+
+  /**
+   * @brief Builds table
+   *
+   * @param hashes Hashes of the keys, must be unique
+   */
+  constexpr explicit PerfectHash(
+      const std::array<std::uint64_t, N> &hashes) {
+    slots_.fill(static_cast<IndexType>(kNotFound));
+
+    std::array<std::size_t, N> order{};
+    for (std::size_t i = 0; i < N; ++i) {
+      order[i] = i;
+    }
+    std::array<std::size_t, kBuckets> bucket_sizes{};
+    for (std::size_t i = 0; i < N; ++i) {
+      ++bucket_sizes[GetBucket(hashes[i])];
+    }
+    auto by_bucket_size = [&](std::size_t lhs, std::size_t rhs) {
+      auto lhs_bucket = GetBucket(hashes[lhs]);
+      auto rhs_bucket = GetBucket(hashes[rhs]);
+      if (bucket_sizes[lhs_bucket] != bucket_sizes[rhs_bucket]) {
+        return bucket_sizes[lhs_bucket] > bucket_sizes[rhs_bucket];
+      }
+      return lhs_bucket < rhs_bucket;
+    };
+    std::sort(order.begin(), order.end(), by_bucket_size);
+
+    for (std::size_t begin = 0; begin < N;) {
+      const std::size_t bucket = GetBucket(hashes[order[begin]]);
+      const std::size_t end = begin + bucket_sizes[bucket];
+      PlaceBucket(hashes, order, begin, end, bucket);
+      begin = end;
+    }
+  }
+
+  /**
+   * @brief Finds index of key
+   *
+   * @param hash Hash of the looked up key
+   * @return std::size_t index of the key or kNotFound
+   */
+  [[nodiscard]] constexpr std::size_t Find(std::uint64_t hash) const noexcept {
+    return slots_[GetSlot(hash, seeds_[GetBucket(hash)])];
+  }
+
+ private:
+  static constexpr std::size_t GetBucket(std::uint64_t hash) noexcept {
+    return MixHash(hash, 0) & (kBuckets - 1);
+  }
+
+  static constexpr std::size_t GetSlot(std::uint64_t hash,
+                                       std::uint32_t seed) noexcept {
+    return MixHash(hash, seed) & (kSlots - 1);
+  }
+
+  constexpr void PlaceBucket(const std::array<std::uint64_t, N> &hashes,
+                             const std::array<std::size_t, N> &order,
+                             std::size_t begin, std::size_t end,
+                             std::size_t bucket) {
+    constexpr std::uint32_t kMaxSeed = 1U << 16;
+    for (std::uint32_t seed = 1; seed < kMaxSeed; ++seed) {
+      bool placed = true;
+      std::size_t i = begin;
+      for (; i < end; ++i) {
+        auto &slot = slots_[GetSlot(hashes[order[i]], seed)];
+        if (slot != kNotFound) {
+          placed = false;
+          break;
+        }
+        slot = static_cast<IndexType>(order[i]);
+      }
+      if (placed) {
+        seeds_[bucket] = seed;
+        return;
+      }
+      for (std::size_t j = begin; j < i; ++j) {
+        slots_[GetSlot(hashes[order[j]], seed)] =
+            static_cast<IndexType>(kNotFound);
+      }
+    }
+    ThrowInvalidArgument("ERROR: Keys of perfect hash aren't unique");
+  }
+
+ private:
+  std::array<std::uint32_t, kBuckets> seeds_{};
+  std::array<IndexType, kSlots> slots_{};
+};
+
+}  // namespace optica::details
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <array>
 #include <concepts>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <type_traits>
 
 #include "fixed_string.hpp"
+#include "variant_set.hpp"
 
 namespace optica {
 
@@ -65,7 +71,7 @@ struct NameProperty : BaseProperty<NameProperty<NameValue>> {
    *
    * @return FixedString value. Name which is hold by NameProperty
    */
-  constexpr static auto GetName() noexcept { return NameValue; }
+  constexpr static const auto &GetName() noexcept { return NameValue; }
 };
 
 namespace details {
@@ -248,7 +254,7 @@ struct ShortNameProperty : BaseProperty<ShortNameProperty<ShortName>> {
    *
    * @return string_view stored short_name
    */
-  constexpr static auto GetShortName() noexcept { return ShortName; }
+  constexpr static const auto &GetShortName() noexcept { return ShortName; }
 };
 
 namespace details {
@@ -325,6 +331,155 @@ concept BindPropertyType = details::is_bind_property<T>::value;
 template <typename... Ts>
 concept HasBindPropertyType = (BindPropertyType<Ts> || ...);
 
+/**
+ * @class ExclusiveGroupPropertyTag
+ * @brief Tag for ExclusiveGroupProperty
+ *
+ */
+struct ExclusiveGroupPropertyTag {};
+
+/**
+ * @struct ExclusiveGroupProperty
+ * @brief Puts option into group of mutually exclusive options
+ *
+ * At most one option of the group may be met in input
+ *
+ * @tparam Group Compile time name of the group
+ */
+template <FixedString Group>
+struct ExclusiveGroupProperty : BaseProperty<ExclusiveGroupProperty<Group>> {
+  using Tag = ExclusiveGroupPropertyTag;
+
+  /**
+   * @brief Returns name of the group
+   *
+   * @return FixedString name of the group
+   */
+  constexpr static const auto &GetExclusiveGroup() noexcept { return Group; }
+};
+
+namespace details {
+template <typename T>
+struct is_exclusive_group_property : std::false_type {};
+
+template <FixedString Group>
+struct is_exclusive_group_property<ExclusiveGroupProperty<Group>>
+    : std::true_type {};
+}  // namespace details
+
+/**
+ * @concept ExclusiveGroupPropertyType
+ * @brief Checks if T is ExclusiveGroupProperty
+ */
+template <typename T>
+concept ExclusiveGroupPropertyType =
+    details::is_exclusive_group_property<T>::value;
+
+/**
+ * @concept HasExclusiveGroupPropertyType
+ * @brief Checks if parameters pack contains ExclusiveGroupProperty
+ */
+template <typename... Ts>
+concept HasExclusiveGroupPropertyType = (ExclusiveGroupPropertyType<Ts> || ...);
+
+/**
+ * @class DescriptionPropertyTag
+ * @brief Tag for DescriptionProperty
+ *
+ */
+struct DescriptionPropertyTag {};
+
+/**
+ * @struct DescriptionProperty
+ * @brief Property holds text of option shown in usage
+ *
+ * @tparam Text Compile time description
+ */
+template <FixedString Text>
+struct DescriptionProperty : BaseProperty<DescriptionProperty<Text>> {
+  using Tag = DescriptionPropertyTag;
+
+  /**
+   * @brief Returns description of option
+   *
+   * @return FixedString description
+   */
+  constexpr static const auto &GetDescription() noexcept { return Text; }
+};
+
+namespace details {
+template <typename T>
+struct is_description_property : std::false_type {};
+
+template <FixedString Text>
+struct is_description_property<DescriptionProperty<Text>> : std::true_type {};
+}  // namespace details
+
+/**
+ * @concept DescriptionPropertyType
+ * @brief Checks if T is DescriptionProperty
+ */
+template <typename T>
+concept DescriptionPropertyType = details::is_description_property<T>::value;
+
+/**
+ * @concept HasDescriptionPropertyType
+ * @brief Checks if parameters pack contains DescriptionProperty
+ */
+template <typename... Ts>
+concept HasDescriptionPropertyType = (DescriptionPropertyType<Ts> || ...);
+
+/**
+ * @class RequiresPropertyTag
+ * @brief Tag for RequiresProperty
+ *
+ */
+struct RequiresPropertyTag {};
+
+/**
+ * @struct RequiresProperty
+ * @brief Tells that options with given names must have values
+ * when this option is met in input
+ *
+ * @tparam Names Compile time names of required options
+ */
+template <FixedString... Names>
+struct RequiresProperty : BaseProperty<RequiresProperty<Names...>> {
+  using Tag = RequiresPropertyTag;
+
+  /**
+   * @brief Returns names of required options
+   *
+   * @return std::array of names
+   */
+  constexpr static std::array<std::string_view, sizeof...(Names)>
+  GetRequiredNames() noexcept {
+    return {std::string_view(Names)...};
+  }
+};
+
+namespace details {
+template <typename T>
+struct is_requires_property : std::false_type {};
+
+template <FixedString... Names>
+struct is_requires_property<RequiresProperty<Names...>> : std::true_type {};
+}  // namespace details
+
+/**
+ * @concept RequiresPropertyType
+ * @brief Checks if T is RequiresProperty
+ */
+template <typename T>
+concept RequiresPropertyType = details::is_requires_property<T>::value;
+
+/**
+ * @concept HasRequiresPropertyType
+ * @brief Checks if parameters pack contains RequiresProperty
+ */
+template <typename... Ts>
+concept HasRequiresPropertyType = (RequiresPropertyType<Ts> || ...);
+
 template <typename... Ts>
 concept SameTypes =
     (std::is_same_v<Ts,
@@ -333,10 +488,26 @@ concept SameTypes =
 
 struct VarianPropertyTag {};
 
+namespace details {
+/**
+ * @brief Type of variants given as Args
+ *
+ * String literals are kept as std::string_view, so literals of different
+ * length form one set
+ */
+template <typename... Args>
+using VariantValueType = std::conditional_t<
+    (std::is_same_v<std::decay_t<Args>, const char *> && ...),
+    std::string_view, std::common_type_t<std::decay_t<Args>...>>;
+}  // namespace details
+
 /**
  * @struct VariantProperty
  * @brief Represents VariantProperty
  *
+ * Parsed value must be one of variants. Check structure is chosen by
+ * \ref details::VariantSet
+ *
  * @tparam ValueType Type of holding variants
  * @tparam N Size of variants
  */
@@ -352,17 +523,26 @@ struct VariantProperty : BaseProperty<VariantProperty<ValueType, N>> {
    */
   template <typename... Args>
     requires(sizeof...(Args) > 1)
-  constexpr VariantProperty(Args &&...args) noexcept
-      : variants{{std::forward<Args>(args)...}} {}
+  constexpr VariantProperty(Args &&...args)
+      : variants{{ValueType(std::forward<Args>(args))...}},
+        variant_set(variants) {}
 
   constexpr const auto &GetVariants() const noexcept { return variants; }
 
+  /**
+   * @brief Checks if value is one of variants
+   */
+  constexpr bool IsVariant(const ValueType &value) const noexcept {
+    return variant_set.Contains(value);
+  }
+
   std::array<ValueType, N> variants;
+  details::VariantSet<ValueType, N> variant_set;
 };
 
 template <typename... Args>
 VariantProperty(Args &&...args)
-    -> VariantProperty<std::common_type_t<Args...>, sizeof...(Args)>;
+    -> VariantProperty<details::VariantValueType<Args...>, sizeof...(Args)>;
 
 namespace details {
 template <typename T>
@@ -406,6 +586,60 @@ using One = Exact<1>;
 using Two = Exact<2>;
 using Three = Exact<3>;
 
+/// Upper bound of arity without limit
+inline constexpr std::size_t kUnboundedArity =
+    std::numeric_limits<std::size_t>::max();
+
+/**
+ * @struct Between
+ * @brief Arity from Min to Max values parsed into resizable container
+ *
+ * Values are words following the option name, the first name stops them
+ *
+ * @tparam Min Minimal number of values
+ * @tparam Max Maximal number of values
+ */
+template <std::size_t Min, std::size_t Max>
+  requires(Min <= Max)
+struct Between {
+  static constexpr std::size_t GetMinArgs() noexcept { return Min; }
+  static constexpr std::size_t GetMaxArgs() noexcept { return Max; }
+};
+
+template <std::size_t N>
+using AtLeast = Between<N, kUnboundedArity>;
+
+template <std::size_t N>
+using AtMost = Between<0, N>;
+
+using Any = Between<0, kUnboundedArity>;
+
+namespace details {
+template <typename T>
+struct is_range_arity : std::false_type {};
+
+template <std::size_t Min, std::size_t Max>
+struct is_range_arity<Between<Min, Max>> : std::true_type {};
+}  // namespace details
+
+template <typename T>
+concept RangeArity = details::is_range_arity<T>::value;
+
+/**
+ * @concept ResizableContainer
+ * @brief Contiguous container holding values of variable arity
+ *
+ * std::vector, std::pmr::vector and small vectors with inline capacity
+ * are accepted
+ */
+template <typename T>
+concept ResizableContainer = requires(T container, std::size_t size) {
+  typename T::value_type;
+  container.clear();
+  container.resize(size);
+  { container.data() } -> std::same_as<typename T::value_type *>;
+};
+
 struct ArityPropertyTag {};
 
 template <typename T>
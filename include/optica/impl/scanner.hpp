@@ -0,0 +1,373 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace optica {
+namespace constants {
+constexpr char kSpace = ' ';
+constexpr char kComma = ',';
+constexpr char kOpenBracket = '{';
+constexpr char kCloseBracket = '}';
+constexpr char kEquals = '=';
+constexpr char kShortPrefix = '-';
+constexpr std::string_view kLongPrefix = "--";
+}  // namespace constants
+
+namespace details {
+
+/**
+ * @brief Sets of symbols separating tokens
+ *
+ * Whole command line is split by spaces, commas and equals signs.
+ * Single argument from argv keeps its spaces, because shell already
+ * split command line into arguments
+ */
+enum class SeparatorSet : std::uint8_t { kCommandLine, kArgument };
+
+/**
+ * @brief Checks if symbol separates tokens
+ *
+ * @tparam Set Separators set
+ * @param symbol Checked symbol
+ * @return bool
+ */
+template <SeparatorSet Set = SeparatorSet::kCommandLine>
+constexpr bool IsSeparator(char symbol) noexcept {
+  return (Set == SeparatorSet::kCommandLine && symbol == constants::kSpace) ||
+         symbol == constants::kComma || symbol == constants::kEquals;
+}
+
+/**
+ * @brief Checks if symbol is curly bracket
+ */
+constexpr bool IsBracket(char symbol) noexcept {
+  return symbol == constants::kOpenBracket ||
+         symbol == constants::kCloseBracket;
+}
+
+/**
+ * @brief Checks if symbol structures compound token
+ */
+constexpr bool IsStructural(char symbol) noexcept {
+  return IsBracket(symbol) || symbol == constants::kComma;
+}
+
+/**
+ * @struct ScalarScanner
+ * @brief Byte by byte structural scanner
+ *
+ * Reference implementation of scanning primitives used by tokenizer.
+ * It's also used in constant evaluation and for block tails.
+ */
+struct ScalarScanner {
+  /**
+   * @brief Skips separators
+   *
+   * @return Pointer to the first non separator symbol or end
+   */
+  template <SeparatorSet Set = SeparatorSet::kCommandLine>
+  static constexpr const char *SkipSeparators(const char *it,
+                                              const char *end) noexcept {
+    while (it != end && IsSeparator<Set>(*it)) {
+      ++it;
+    }
+    return it;
+  }
+
+  /**
+   * @brief Finds separator
+   *
+   * @return Pointer to the first separator symbol or end
+   */
+  template <SeparatorSet Set = SeparatorSet::kCommandLine>
+  static constexpr const char *FindSeparator(const char *it,
+                                             const char *end) noexcept {
+    while (it != end && !IsSeparator<Set>(*it)) {
+      ++it;
+    }
+    return it;
+  }
+
+  /**
+   * @brief Finds symbol
+   *
+   * @return Pointer to the first occurrence of symbol or end
+   */
+  static constexpr const char *Find(const char *it, const char *end,
+                                    char symbol) noexcept {
+    while (it != end && *it != symbol) {
+      ++it;
+    }
+    return it;
+  }
+
+  /**
+   * @brief Finds curly bracket
+   *
+   * @return Pointer to the first opening or closing bracket or end
+   */
+  static constexpr const char *FindBracket(const char *it,
+                                           const char *end) noexcept {
+    while (it != end && !IsBracket(*it)) {
+      ++it;
+    }
+    return it;
+  }
+
+  /**
+   * @brief Finds structural symbol of compound token
+   *
+   * @return Pointer to the first comma or curly bracket or end
+   */
+  static constexpr const char *FindStructural(const char *it,
+                                              const char *end) noexcept {
+    while (it != end && !IsStructural(*it)) {
+      ++it;
+    }
+    return it;
+  }
+
+  /**
+   * @brief Counts symbol occurrences
+   *
+   * @return std::size_t number of symbols in range
+   */
+  static constexpr std::size_t Count(const char *it, const char *end,
+                                     char symbol) noexcept {
+    std::size_t result = 0;
+    for (; it != end; ++it) {
+      result += *it == symbol;
+    }
+    return result;
+  }
+};
+
+#if defined(__SSE2__) || defined(_M_X64)
+/**
+ * @struct Sse2Block
+ * @brief Classifies 16 bytes at once
+ */
+struct Sse2Block {
+  static constexpr std::size_t kWidth = 16;
+  static constexpr std::uint32_t kFull = 0xFFFF;
+
+  template <SeparatorSet Set>
+  static std::uint32_t Separators(const char *data) noexcept {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    const __m128i commas =
+        _mm_cmpeq_epi8(chunk, _mm_set1_epi8(constants::kComma));
+    const __m128i equals =
+        _mm_cmpeq_epi8(chunk, _mm_set1_epi8(constants::kEquals));
+    __m128i mask = _mm_or_si128(commas, equals);
+    if constexpr (Set == SeparatorSet::kCommandLine) {
+      mask = _mm_or_si128(
+          mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(constants::kSpace)));
+    }
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(mask));
+  }
+
+  static std::uint32_t Equal(const char *data, char symbol) noexcept {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(symbol))));
+  }
+
+  template <bool WithCommas>
+  static std::uint32_t Structural(const char *data) noexcept {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    __m128i mask = _mm_or_si128(
+        _mm_cmpeq_epi8(chunk, _mm_set1_epi8(constants::kOpenBracket)),
+        _mm_cmpeq_epi8(chunk, _mm_set1_epi8(constants::kCloseBracket)));
+    if constexpr (WithCommas) {
+      mask = _mm_or_si128(
+          mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(constants::kComma)));
+    }
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(mask));
+  }
+};
+#endif
+
+#if defined(__AVX2__)
+/**
+ * @struct Avx2Block
+ * @brief Classifies 32 bytes at once
+ */
+struct Avx2Block {
+  static constexpr std::size_t kWidth = 32;
+  static constexpr std::uint32_t kFull = 0xFFFFFFFF;
+
+  template <SeparatorSet Set>
+  static std::uint32_t Separators(const char *data) noexcept {
+    const __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+    const __m256i commas =
+        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(constants::kComma));
+    const __m256i equals =
+        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(constants::kEquals));
+    __m256i mask = _mm256_or_si256(commas, equals);
+    if constexpr (Set == SeparatorSet::kCommandLine) {
+      mask = _mm256_or_si256(
+          mask, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(constants::kSpace)));
+    }
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(mask));
+  }
+
+  static std::uint32_t Equal(const char *data, char symbol) noexcept {
+    const __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(symbol))));
+  }
+
+  template <bool WithCommas>
+  static std::uint32_t Structural(const char *data) noexcept {
+    const __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+    __m256i mask = _mm256_or_si256(
+        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(constants::kOpenBracket)),
+        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(constants::kCloseBracket)));
+    if constexpr (WithCommas) {
+      mask = _mm256_or_si256(
+          mask, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(constants::kComma)));
+    }
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(mask));
+  }
+};
+#endif
+
+/**
+ * @struct SimdScanner
+ * @brief Structural scanner working on whole blocks
+ *
+ * Every block is classified into bitmask where each bit tells whether
+ * corresponding byte is structural. Token boundaries are taken from the
+ * lowest set bit of the mask. Tails shorter than block and constant
+ * evaluation fall back to \ref ScalarScanner
+ *
+ * @tparam Block Block classifier
+ */
+template <typename Block>
+struct SimdScanner {
+  template <SeparatorSet Set = SeparatorSet::kCommandLine>
+  static constexpr const char *SkipSeparators(const char *it,
+                                              const char *end) noexcept {
+    if consteval {
+      return ScalarScanner::SkipSeparators<Set>(it, end);
+    } else {
+      for (; static_cast<std::size_t>(end - it) >= Block::kWidth;
+           it += Block::kWidth) {
+        const std::uint32_t mask =
+            ~Block::template Separators<Set>(it) & Block::kFull;
+        if (mask != 0) {
+          return it + std::countr_zero(mask);
+        }
+      }
+      return ScalarScanner::SkipSeparators<Set>(it, end);
+    }
+  }
+
+  template <SeparatorSet Set = SeparatorSet::kCommandLine>
+  static constexpr const char *FindSeparator(const char *it,
+                                             const char *end) noexcept {
+    if consteval {
+      return ScalarScanner::FindSeparator<Set>(it, end);
+    } else {
+      for (; static_cast<std::size_t>(end - it) >= Block::kWidth;
+           it += Block::kWidth) {
+        const std::uint32_t mask = Block::template Separators<Set>(it);
+        if (mask != 0) {
+          return it + std::countr_zero(mask);
+        }
+      }
+      return ScalarScanner::FindSeparator<Set>(it, end);
+    }
+  }
+
+  static constexpr const char *Find(const char *it, const char *end,
+                                    char symbol) noexcept {
+    if consteval {
+      return ScalarScanner::Find(it, end, symbol);
+    } else {
+      for (; static_cast<std::size_t>(end - it) >= Block::kWidth;
+           it += Block::kWidth) {
+        const std::uint32_t mask = Block::Equal(it, symbol);
+        if (mask != 0) {
+          return it + std::countr_zero(mask);
+        }
+      }
+      return ScalarScanner::Find(it, end, symbol);
+    }
+  }
+
+  static constexpr const char *FindBracket(const char *it,
+                                           const char *end) noexcept {
+    if consteval {
+      return ScalarScanner::FindBracket(it, end);
+    } else {
+      return FindMasked<false>(it, end);
+    }
+  }
+
+  static constexpr const char *FindStructural(const char *it,
+                                              const char *end) noexcept {
+    if consteval {
+      return ScalarScanner::FindStructural(it, end);
+    } else {
+      return FindMasked<true>(it, end);
+    }
+  }
+
+  static constexpr std::size_t Count(const char *it, const char *end,
+                                     char symbol) noexcept {
+    if consteval {
+      return ScalarScanner::Count(it, end, symbol);
+    } else {
+      std::size_t result = 0;
+      for (; static_cast<std::size_t>(end - it) >= Block::kWidth;
+           it += Block::kWidth) {
+        result += std::popcount(Block::Equal(it, symbol));
+      }
+      return result + ScalarScanner::Count(it, end, symbol);
+    }
+  }
+
+ private:
+  template <bool WithCommas>
+  static const char *FindMasked(const char *it, const char *end) noexcept {
+    for (; static_cast<std::size_t>(end - it) >= Block::kWidth;
+         it += Block::kWidth) {
+      const std::uint32_t mask = Block::template Structural<WithCommas>(it);
+      if (mask != 0) {
+        return it + std::countr_zero(mask);
+      }
+    }
+    return WithCommas ? ScalarScanner::FindStructural(it, end)
+                      : ScalarScanner::FindBracket(it, end);
+  }
+};
+
+/**
+ * @brief Best scanner available for target
+ */
+#if defined(__AVX2__)
+using DefaultScanner = SimdScanner<Avx2Block>;
+#elif defined(__SSE2__) || defined(_M_X64)
+using DefaultScanner = SimdScanner<Sse2Block>;
+#else
+using DefaultScanner = ScalarScanner;
+#endif
+
+}  // namespace details
+}  // namespace optica
@@ -1,25 +1,48 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <expected>
 #include <format>
 #include <print>
 #include <ranges>
 #include <string_view>
+
+#include "error.hpp"
+#include "scanner.hpp"
+
 namespace optica {
-namespace constants {
-constexpr char kSpace = ' ';
-constexpr char kComma = ',';
-constexpr char kOpenBracket = '{';
-constexpr char kCloseBracket = '}';
-constexpr char kEquals = '=';
-constexpr char kShortPrefix = '-';
-constexpr std::string_view kLongPrefix = "--";
-}  // namespace constants
 
 class TokenIterator;
 class Tokenizer;
 
+namespace details {
+/**
+ * @brief Finds bracket closing already opened one
+ *
+ * Nested brackets are balanced, so only structural symbols found by
+ * Scanner are visited
+ *
+ * @tparam Scanner Structural scanner
+ * @param it Position right after opening bracket
+ * @param end End of the sequence
+ * @return Pointer to matching closing bracket or end if it's missing
+ */
+template <typename Scanner>
+constexpr const char *FindClosingBracket(const char *it,
+                                         const char *end) noexcept {
+  std::size_t depth = 1;
+  for (it = Scanner::FindBracket(it, end); it != end;
+       it = Scanner::FindBracket(it + 1, end)) {
+    depth += *it == constants::kOpenBracket ? 1 : -1;
+    if (depth == 0) {
+      break;
+    }
+  }
+  return it;
+}
+}  // namespace details
+
 /**
  * @class Token
  * @brief This class represents token extracted from string
@@ -32,7 +55,13 @@ struct Token {
   /**
    * @brief Token types
    */
-  enum class TokenType { None = 0, Word, LongName, ShortName, CompoundName };
+  enum class TokenType : std::uint8_t {
+    None = 0,
+    Word,
+    LongName,
+    ShortName,
+    CompoundName
+  };
 
   /**
    * @brief Default constructor
@@ -45,11 +74,7 @@ struct Token {
    * @param type type of a token
    */
   constexpr Token(std::string_view data, TokenType type) noexcept
-      : data_(data),
-        type_(type),
-        token_size_(std::count_if(data_.begin(), data_.end(),
-                                  [](auto symbol) { return symbol == ','; }) +
-                    1) {}
+      : data_(data), type_(type) {}
 
   /**
    * @brief Checks if two tokens are equal
@@ -79,73 +104,306 @@ struct Token {
    * for general arguments it equals to 1, but for compound tokens it can be
    * more. In terms of CMD string compound token is something like {1, 2, 3}.
    * After parsing this string you'll get Token with size of 3
+   *
+   * @note Size isn't stored inside token, it's computed on each call.
+   * Commas of nested compound values like `{1, {2, 3}}` aren't counted
    */
-  [[nodiscard]] constexpr std::size_t GetTokenSize() const noexcept {
-    return token_size_;
-  }
+  [[nodiscard]] constexpr std::size_t GetTokenSize() const noexcept;
 
   // TODO: Make doc
   [[nodiscard]] constexpr TokenType GetTokenType() const noexcept {
     return type_;
   }
 
+  /**
+   * @brief Splits compound token into units
+   *
+   * Units are separated by commas, surrounding spaces are dropped.
+   * Token is walked only once, so extraction costs O(token length)
+   *
+   * @tparam N Maximum number of units
+   * @return std::array<Token, N> Extracted units, missing ones are empty
+   * @throws std::invalid_argument if token has more than N units
+   */
   template <std::size_t N>
   constexpr auto ExtractTokenUnits() const {
-    std::array<Token, N> result{};
-    const char *start = data_.data();
-    const char *end = data_.data() + data_.size();
-    const char *current = start;
-    std::size_t idx = 0;
-
-    // if (token_size_ > N) {
-    //   throw "Sosal";
-    // }
-    if (N < token_size_) {
-      if consteval {
-      } else {
-        std::string res;
-        std::format_to(std::back_inserter(res),
-                       "ERROR: Extraction {} subtokens from {} sized token", N,
-                       token_size_);
-        throw std::invalid_argument(res);
-      }
+    auto result = TryExtractTokenUnits<N>();
+    if (!result) {
+      std::string res;
+      std::format_to(std::back_inserter(res),
+                     "ERROR: Extraction {} subtokens from {} sized token", N,
+                     GetTokenSize());
+      details::ThrowInvalidArgument(res);
     }
+    return *result;
+  }
+
+  /**
+   * @brief Splits compound token into units without throwing
+   *
+   * @tparam N Maximum number of units
+   * @return std::expected with extracted units or ErrorCode::TooManyUnits
+   */
+  template <std::size_t N>
+  constexpr std::expected<std::array<Token, N>, ErrorCode>
+  TryExtractTokenUnits() const noexcept;
+
+ private:
+  friend std::formatter<Token>;
+  friend TokenIterator;
+
+ private:
+  std::string_view data_;
+  TokenType type_{TokenType::None};
+};
+
+namespace details {
+
+/**
+ * @class UnitCursor
+ * @brief Walks units of compound token one by one
+ *
+ * Units are separated by commas, surrounding spaces are dropped.
+ * Cursor keeps only position in token, so units are decoded
+ * right where they are found
+ */
+class UnitCursor {
+ public:
+  constexpr explicit UnitCursor(std::string_view data) noexcept
+      : current_(data.data()), end_(data.data() + data.size()) {}
 
-    while (current != end) {
-      if (*current == ' ') {
-        ++start;
-        ++current;
-        continue;
+  /**
+   * @brief Moves to the next unit
+   *
+   * Nested compound unit like `{2, 3}` is a single unit of
+   * CompoundName type without its brackets
+   *
+   * @param unit Next unit
+   * @return bool false if token is exhausted
+   */
+  constexpr bool Next(Token &unit) noexcept {
+    if (done_) {
+      return false;
+    }
+    const char *comma = DefaultScanner::FindStructural(current_, end_);
+    while (comma != end_ && *comma != constants::kComma) {
+      if (*comma == constants::kOpenBracket) {
+        comma = FindClosingBracket<DefaultScanner>(comma + 1, end_);
+      }
+      if (comma != end_) {
+        comma = DefaultScanner::FindStructural(comma + 1, end_);
       }
+    }
+    const char *unit_begin = current_;
+    const char *unit_end = comma;
+    while (unit_begin != unit_end && *unit_begin == constants::kSpace) {
+      ++unit_begin;
+    }
+    while (unit_end != unit_begin && *(unit_end - 1) == constants::kSpace) {
+      --unit_end;
+    }
+
+    done_ = comma == end_;
+    if (done_ && unit_begin == unit_end) {
+      return false;
+    }
+    if (unit_end - unit_begin >= 2 && *unit_begin == constants::kOpenBracket &&
+        *(unit_end - 1) == constants::kCloseBracket) {
+      unit = Token(std::string_view(unit_begin + 1, unit_end - 1),
+                   Token::TokenType::CompoundName);
+    } else {
+      unit = Token(std::string_view(unit_begin, unit_end),
+                   Token::TokenType::Word);
+    }
+    current_ = done_ ? end_ : comma + 1;
+    return true;
+  }
+
+ private:
+  const char *current_;
+  const char *end_;
+  bool done_{};
+};
 
-      if (*current == constants::kComma) {
-        result[idx++] =
-            Token(std::string_view(start, current - start), TokenType::Word);
-        ++current;
-        start = current;
-      } else {
-        ++current;
+/**
+ * @brief Counts units of value token the way \ref UnitCursor walks them
+ *
+ * Compound and empty tokens are a single unit. Commas are counted
+ * in bulk unless token has nested compound units
+ */
+constexpr std::size_t CountUnits(const Token &token) noexcept {
+  const std::string_view data = token.GetTokenData();
+  if (token.GetTokenType() == Token::TokenType::CompoundName || data.empty()) {
+    return 1;
+  }
+  const char *begin = data.data();
+  const char *end = begin + data.size();
+  // Blank unit after the last comma is dropped
+  const char *tail = end;
+  while (tail != begin && *(tail - 1) == constants::kSpace) {
+    --tail;
+  }
+  const std::size_t blank =
+      tail == begin || *(tail - 1) == constants::kComma ? 1 : 0;
+  const char *structural = DefaultScanner::FindStructural(begin, end);
+  if (structural == end) {
+    return 1 - blank;
+  }
+  if (DefaultScanner::FindBracket(structural, end) == end) {
+    return DefaultScanner::Count(structural, end, constants::kComma) + 1 -
+           blank;
+  }
+  std::size_t size = 0;
+  UnitCursor cursor{data};
+  for (Token unit; cursor.Next(unit);) {
+    ++size;
+  }
+  return size;
+}
+
+/**
+ * @class ValueCursor
+ * @brief Walks values of option across its value tokens
+ *
+ * Tokens of whole command line never hold commas, while program
+ * argument like `640,480` is a single token of two units. Value
+ * attached to short name goes first. Values end at the next name
+ *
+ * @tparam Iterator Iterator over tokens
+ */
+template <typename Iterator>
+class ValueCursor {
+ public:
+  /**
+   * @param attached Value attached to short name or nullptr
+   * @param it First token after name token
+   * @param end End of tokens
+   */
+  constexpr ValueCursor(const Token *attached, Iterator it,
+                        Iterator end) noexcept
+      : attached_(attached), it_(it), end_(end) {}
+
+  /**
+   * @brief Moves to the next value
+   *
+   * @param value Next value, Word or CompoundName
+   * @return bool false if values are exhausted
+   */
+  constexpr bool Next(Token &value) noexcept {
+    while (true) {
+      if (in_token_ && units_.Next(value)) {
+        return true;
+      }
+      Token token;
+      if (!NextToken(token)) {
+        return false;
+      }
+      // Compound and empty values are units themselves
+      if (token.GetTokenType() == Token::TokenType::CompoundName ||
+          token.GetTokenData().empty()) {
+        value = token;
+        return true;
       }
+      units_ = UnitCursor{token.GetTokenData()};
+      in_token_ = true;
     }
+  }
 
-    if (start != end) {
-      result[idx++] =
-          Token(std::string_view(start, end - start), TokenType::Word);
+  /**
+   * @brief Moves to the next value token as a whole
+   *
+   * Units of the token are left to the caller, so list in a single
+   * token is decoded in one pass. Units of the current token not
+   * taken by \ref Next are skipped
+   *
+   * @param token Next token, Word or CompoundName
+   * @return bool false if values are exhausted
+   */
+  constexpr bool NextToken(Token &token) noexcept {
+    in_token_ = false;
+    if (attached_ != nullptr) {
+      token = *attached_;
+      attached_ = nullptr;
+      offset_ = 0;
+      return true;
     }
+    if (it_ == end_) {
+      return false;
+    }
+    token = *it_;
+    if (token.GetTokenType() != Token::TokenType::Word &&
+        token.GetTokenType() != Token::TokenType::CompoundName) {
+      return false;
+    }
+    ++it_;
+    offset_ = next_offset_++;
+    return true;
+  }
 
-    return result;
+  /**
+   * @brief Checks if the current token has units not taken by \ref Next
+   */
+  [[nodiscard]] constexpr bool HasPendingUnits() const noexcept {
+    if (!in_token_) {
+      return false;
+    }
+    UnitCursor units = units_;
+    Token unit;
+    return units.Next(unit);
   }
 
- private:
-  friend std::formatter<Token>;
-  friend TokenIterator;
+  /**
+   * @brief Get offset of token holding the last value from name token
+   *
+   * Attached value is a part of name token, so its offset is 0
+   */
+  [[nodiscard]] constexpr std::size_t GetOffset() const noexcept {
+    return offset_;
+  }
 
  private:
-  std::string_view data_;
-  TokenType type_{TokenType::None};
-  std::size_t token_size_{};
+  const Token *attached_;
+  Iterator it_;
+  Iterator end_;
+  UnitCursor units_{std::string_view{}};
+  std::size_t offset_{};
+  std::size_t next_offset_{1};
+  bool in_token_{};
 };
 
+}  // namespace details
+
+constexpr std::size_t Token::GetTokenSize() const noexcept {
+  const char *begin = data_.data();
+  const char *end = begin + data_.size();
+  if (details::DefaultScanner::Find(begin, end, constants::kOpenBracket) ==
+      end) {
+    return details::DefaultScanner::Count(begin, end, constants::kComma) + 1;
+  }
+  std::size_t size = 0;
+  details::UnitCursor cursor{data_};
+  for (Token unit; cursor.Next(unit);) {
+    ++size;
+  }
+  return size;
+}
+
+template <std::size_t N>
+constexpr std::expected<std::array<Token, N>, ErrorCode>
+Token::TryExtractTokenUnits() const noexcept {
+  std::array<Token, N> result{};
+  details::UnitCursor cursor{data_};
+  std::size_t idx = 0;
+  Token unit;
+  while (cursor.Next(unit)) {
+    if (idx == N) {
+      return std::unexpected(ErrorCode::TooManyUnits);
+    }
+    result[idx++] = unit;
+  }
+  return result;
+}
+
 constexpr std::string_view to_string(Token::TokenType type) {
   using enum Token::TokenType;
   switch (type) {
@@ -164,6 +422,57 @@ constexpr std::string_view to_string(Token::TokenType type) {
   }
 }
 
+namespace details {
+
+/**
+ * @brief Extracts next token from sequence of chars
+ *
+ * @tparam Scanner Structural scanner used for searching boundaries
+ * @tparam Set Symbols separating tokens
+ * @param current Current position, moved past extracted token
+ * @param end End of the sequence
+ * @return Token extracted token or empty Token if sequence is exhausted
+ *
+ * @remark Short name token holds whole cluster of short names, so `-abc`
+ * is a single token with data `abc`. Dash followed by digit starts
+ * a negative number like `-42`, which is a word
+ */
+template <typename Scanner, SeparatorSet Set = SeparatorSet::kCommandLine>
+constexpr Token ScanToken(const char *&current, const char *end) noexcept {
+  const char *start = Scanner::template SkipSeparators<Set>(current, end);
+
+  if (start == end) {
+    current = end;
+    return Token{};
+  }
+
+  if (*start == constants::kOpenBracket) {
+    const char *close = FindClosingBracket<Scanner>(start + 1, end);
+    current = close == end ? end : close + 1;
+    return Token{std::string_view(start + 1, close),
+                 Token::TokenType::CompoundName};
+  }
+
+  if (*start == constants::kShortPrefix && start + 1 != end &&
+      *(start + 1) == constants::kShortPrefix) {
+    current = Scanner::template FindSeparator<Set>(start + 2, end);
+    return Token{std::string_view(start + 2, current),
+                 Token::TokenType::LongName};
+  }
+
+  if (*start == constants::kShortPrefix &&
+      !(start + 1 != end && *(start + 1) >= '0' && *(start + 1) <= '9')) {
+    current = Scanner::template FindSeparator<Set>(start + 1, end);
+    return Token{std::string_view(start + 1, current),
+                 Token::TokenType::ShortName};
+  }
+
+  current = Scanner::template FindSeparator<Set>(start, end);
+  return Token{std::string_view(start, current), Token::TokenType::Word};
+}
+
+}  // namespace details
+
 /**
  * @class TokenIterator
  * @brief Iterator on string_view
@@ -229,139 +538,8 @@ class TokenIterator {
 
  private:
   constexpr void ParseToken() noexcept {
-    const auto *current_copy = current_;
-    auto skip_chars = [](char symbol) {
-      return symbol == constants::kSpace || symbol == constants::kComma ||
-             symbol == constants::kEquals;
-    };
-
-    current_copy = std::find_if_not(current_copy, end_, skip_chars);
-
-    if (current_copy == end_) {
-      current_token_ = Token{};
-      return;
-    }
-
-    if (current_copy == current_ &&
-        current_token_.type_ == Token::TokenType::ShortName) {
-      current_token_ =
-          Token(std::string_view(current_copy, 1), Token::TokenType::ShortName);
-      ++current_;
-      return;
-    }
-
-    auto determine_type = [](const char *start, const char *end) {
-      if (start == end) {
-        return Token::TokenType::None;
-      }
-      if (*start == constants::kOpenBracket) {
-        return Token::TokenType::CompoundName;
-      }
-      if (*start == constants::kShortPrefix and (start + 1 != end) and
-          *(start + 1) == constants::kShortPrefix) {
-        return Token::TokenType::LongName;
-      }
-      if (*start == constants::kShortPrefix) {
-        return Token::TokenType::ShortName;
-      }
-      return Token::TokenType::Word;
-    };
-
-    Token::TokenType type = determine_type(current_copy, end_);
-
-    switch (type) {
-      case Token::TokenType::LongName: {
-        const auto *start = current_copy + 2;
-        auto end = std::find_if(start, end_, [](char symbol) {
-          return symbol == constants::kComma || symbol == constants::kSpace ||
-                 symbol == constants::kEquals;
-        });
-        current_token_ = Token{std::string_view(start, end), type};
-        current_ = end;
-        return;
-      }
-      case Token::TokenType::ShortName: {
-        current_token_ =
-            Token{std::string_view(current_copy + 1, current_copy + 2), type};
-        current_ = current_copy + 2;
-        return;
-      }
-      case Token::TokenType::Word: {
-        const auto *end = std::find_if(current_copy, end_, [](char symbol) {
-          return symbol == constants::kComma || symbol == constants::kSpace ||
-                 symbol == constants::kEquals;
-        });
-        current_token_ = Token{std::string_view(current_copy, end), type};
-        current_ = end;
-        return;
-      }
-      case Token::TokenType::CompoundName: {
-        const auto *end = std::find_if(current_copy, end_, [](char symbol) {
-          return symbol == constants::kCloseBracket;
-        });
-        current_token_ = Token{std::string_view(current_copy + 1, end), type};
-        current_ = end + 1;
-        return;
-      }
-    }
-  }
-
-  constexpr void parse_token() noexcept {
-    // пропускаем пробелы
-    auto current_copy = current_;
-    while (current_ != end_ &&
-           (*current_ == ' ' || *current_ == ',' || *current_ == '=')) {
-      ++current_;
-    }
-    if (current_ == end_) {
-      current_token_ = Token{};
-      return;
-    }
-
-    if (current_copy == current_ &&
-        current_token_.type_ == Token::TokenType::ShortName) {
-      current_token_ =
-          Token(std::string_view(current_copy, 1), Token::TokenType::ShortName);
-      ++current_;
-      return;
-    }
-
-    Token::TokenType type = Token::TokenType::Word;
-    const char *start = current_;
-
-    if (*start == '{') {
-      type = Token::TokenType::CompoundName;
-    }
-    if (*start == '-') {
-      type = Token::TokenType::ShortName;
-    }
-    if (*(start + 1) == '-') {
-      type = Token::TokenType::LongName;
-    }
-
-    if (type == Token::TokenType::CompoundName) {
-      while (current_ != end_ && *current_ != '}') {
-        ++current_;
-      }
-      ++current_;
-    } else if (type == Token::TokenType::ShortName) {
-      current_ += 2;
-    } else {
-      while (current_ != end_ && *current_ != ' ' && *current_ != ',' &&
-             *current_ != '=') {
-        ++current_;
-      }
-    }
-    if (type == Token::TokenType::LongName) {
-      current_token_ = Token(std::string_view(start + 2, current_), type);
-      return;
-    } else if (type == Token::TokenType::ShortName) {
-      current_token_ = Token(std::string_view(start + 1, current_), type);
-      return;
-    }
-    current_token_ = Token(
-        std::string_view(start, static_cast<std::size_t>(current_ - start)),
-        type);
+    current_token_ =
+        details::ScanToken<details::DefaultScanner>(current_, end_);
   }
 
  private:
@@ -418,6 +596,6 @@ struct std::formatter<optica::Token> {
   auto format(const optica::Token &token, FormatContext &ctx) const {
     return std::format_to(ctx.out(), "Token(data=\"{}\", type={}, size={})",
                           token.data_, to_string(token.type_),
-                          token.token_size_);
+                          token.GetTokenSize());
   }
 };
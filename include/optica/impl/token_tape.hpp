@@ -0,0 +1,382 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+#include "token.hpp"
+
+namespace optica {
+
+class TokenTape;
+
+/**
+ * @class TokenTapeIterator
+ * @brief Random access iterator over \ref TokenTape
+ *
+ * Dereferencing materializes \ref Token from tape entry,
+ * so advancing and lookahead never touch source string.
+ */
+class TokenTapeIterator {
+ public:
+  using iterator_concept = std::random_access_iterator_tag;
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = Token;
+  using reference = Token;
+  using difference_type = std::ptrdiff_t;
+
+  /**
+   * @brief Default constructor
+   */
+  constexpr TokenTapeIterator() noexcept = default;
+
+  /**
+   * @brief Constructs iterator pointing to tape entry
+   *
+   * @param tape Iterated tape
+   * @param index Index of the entry
+   */
+  constexpr TokenTapeIterator(const TokenTape *tape, std::size_t index) noexcept
+      : tape_(tape), index_(index) {}
+
+  constexpr Token operator*() const noexcept;
+  constexpr Token operator[](difference_type offset) const noexcept;
+
+  constexpr TokenTapeIterator &operator++() noexcept {
+    ++index_;
+    return *this;
+  }
+  constexpr TokenTapeIterator operator++(int) noexcept {
+    auto copy = *this;
+    ++index_;
+    return copy;
+  }
+  constexpr TokenTapeIterator &operator--() noexcept {
+    --index_;
+    return *this;
+  }
+  constexpr TokenTapeIterator operator--(int) noexcept {
+    auto copy = *this;
+    --index_;
+    return copy;
+  }
+  constexpr TokenTapeIterator &operator+=(difference_type offset) noexcept {
+    index_ += offset;
+    return *this;
+  }
+  constexpr TokenTapeIterator &operator-=(difference_type offset) noexcept {
+    index_ -= offset;
+    return *this;
+  }
+
+  friend constexpr TokenTapeIterator operator+(
+      TokenTapeIterator it, difference_type offset) noexcept {
+    return it += offset;
+  }
+  friend constexpr TokenTapeIterator operator+(
+      difference_type offset, TokenTapeIterator it) noexcept {
+    return it += offset;
+  }
+  friend constexpr TokenTapeIterator operator-(
+      TokenTapeIterator it, difference_type offset) noexcept {
+    return it -= offset;
+  }
+  friend constexpr difference_type operator-(
+      const TokenTapeIterator &lhs, const TokenTapeIterator &rhs) noexcept {
+    return static_cast<difference_type>(lhs.index_) -
+           static_cast<difference_type>(rhs.index_);
+  }
+
+  constexpr bool operator==(const TokenTapeIterator &other) const noexcept {
+    return index_ == other.index_;
+  }
+  constexpr auto operator<=>(const TokenTapeIterator &other) const noexcept {
+    return index_ <=> other.index_;
+  }
+
+  /**
+   * @brief Get position of iterator inside tape
+   *
+   * @return std::size_t index of the entry
+   */
+  [[nodiscard]] constexpr std::size_t GetIndex() const noexcept {
+    return index_;
+  }
+
+ private:
+  const TokenTape *tape_{};
+  std::size_t index_{};
+};
+
+static_assert(std::random_access_iterator<TokenTapeIterator>);
+
+/**
+ * @class TokenTape
+ * @brief Flat storage of all tokens of the input
+ *
+ * Input is tokenized once into struct of arrays of token starts, lengths and
+ * types. Tape may be rebuilt for another input, in this case already
+ * allocated memory is reused.
+ *
+ * @code{.cpp}
+ * optica::TokenTape tape;
+ * for (auto command : commands) {
+ *   tape.Build(command);
+ *   auto result = parser.Parse(tape);
+ * }
+ * @endcode
+ *
+ * @warning Tape doesn't own input, it must outlive the tape
+ */
+class TokenTape {
+ public:
+  using iterator = TokenTapeIterator;
+  using const_iterator = TokenTapeIterator;
+
+  /**
+   * @brief Default constructor
+   */
+  constexpr TokenTape() noexcept = default;
+
+  /**
+   * @brief Constructs tape from sequence of chars
+   *
+   * @param data std::string_view with sequence of chars
+   */
+  constexpr explicit TokenTape(std::string_view data) { Build(data); }
+
+  /**
+   * @brief Constructs tape from program arguments
+   *
+   * @param argc Number of arguments
+   * @param argv Arguments
+   */
+  constexpr TokenTape(int argc, const char *const *argv) { Build(argc, argv); }
+
+  /**
+   * @brief Tokenizes input replacing previous content
+   *
+   * @param data std::string_view with sequence of chars
+   */
+  constexpr void Build(std::string_view data) {
+    Clear();
+    source_ = data;
+    const char *current = data.data();
+    const char *end = data.data() + data.size();
+
+    while (true) {
+      Token token = details::ScanToken<details::DefaultScanner>(current, end);
+      if (token.GetTokenType() == Token::TokenType::None) {
+        break;
+      }
+      Push(token);
+    }
+  }
+
+  /**
+   * @brief Tokenizes program arguments replacing previous content
+   *
+   * Every argument is tokenized in place, so tokens point straight into
+   * argv. Shell already split command line into arguments, so value
+   * argument like `a b` or `x=1,y=2` is a single token. Only option
+   * argument like `--name=value` or `-d=42` is split at the first `=`.
+   * Commas inside value are left for options with lists or compound
+   * values. First argument is treated as program name and skipped
+   *
+   * @param argc Number of arguments
+   * @param argv Arguments
+   */
+  constexpr void Build(int argc, const char *const *argv) {
+    Clear();
+    argc_ = argc;
+    argv_ = argv;
+    for (int i = 1; i < argc; ++i) {
+      PushArgument(argv[i]);
+    }
+  }
+
+  /**
+   * @brief Removes all tokens keeping allocated memory
+   */
+  constexpr void Clear() noexcept {
+    begins_.clear();
+    lengths_.clear();
+    types_.clear();
+    source_ = {};
+    argc_ = 0;
+    argv_ = nullptr;
+  }
+
+  /**
+   * @brief Get number of tokens
+   */
+  [[nodiscard]] constexpr std::size_t size() const noexcept {
+    return types_.size();
+  }
+
+  /**
+   * @brief Checks if tape has no tokens
+   */
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return types_.empty();
+  }
+
+  /**
+   * @brief Get number of tokens tape can hold without allocation
+   */
+  [[nodiscard]] constexpr std::size_t Capacity() const noexcept {
+    return types_.capacity();
+  }
+
+  /**
+   * @brief Get token by index
+   *
+   * @param index Index of the token
+   * @return Token or empty Token if index is out of tape
+   */
+  [[nodiscard]] constexpr Token operator[](std::size_t index) const noexcept {
+    if (index >= types_.size()) {
+      return Token{};
+    }
+    return Token{std::string_view(begins_[index], lengths_[index]),
+                 types_[index]};
+  }
+
+  /**
+   * @brief Get type of token by index without materializing it
+   *
+   * @param index Index of the token
+   * @return Token::TokenType
+   */
+  [[nodiscard]] constexpr Token::TokenType GetTokenType(
+      std::size_t index) const noexcept {
+    return index < types_.size() ? types_[index] : Token::TokenType::None;
+  }
+
+  /**
+   * @brief Get byte offset of position from the start of input
+   *
+   * Program arguments are counted as if they were joined with single
+   * spaces. Offset is computed by walking arguments, so it's meant for
+   * error reporting only
+   *
+   * @param position Pointer into tokenized input
+   * @return std::size_t offset of position
+   */
+  [[nodiscard]] constexpr std::size_t GetOffset(
+      const char *position) const noexcept {
+    if (argv_ == nullptr) {
+      return static_cast<std::size_t>(position - source_.data());
+    }
+    std::size_t offset = 0;
+    for (int i = 1; i < argc_; ++i) {
+      std::string_view argument = argv_[i];
+      const char *argument_end = argument.data() + argument.size();
+      if (std::less_equal<>{}(argument.data(), position) &&
+          std::less_equal<>{}(position, argument_end)) {
+        return offset + static_cast<std::size_t>(position - argument.data());
+      }
+      offset += argument.size() + 1;
+    }
+    return offset;
+  }
+
+  /**
+   * @brief Get size of input in bytes
+   *
+   * Program arguments are counted as if they were joined with single
+   * spaces
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] constexpr std::size_t GetInputSize() const noexcept {
+    if (argv_ == nullptr) {
+      return source_.size();
+    }
+    std::size_t size = 0;
+    for (int i = 1; i < argc_; ++i) {
+      size += std::string_view(argv_[i]).size() + (i > 1 ? 1 : 0);
+    }
+    return size;
+  }
+
+  [[nodiscard]] constexpr TokenTapeIterator begin() const noexcept {
+    return TokenTapeIterator{this, 0};
+  }
+
+  [[nodiscard]] constexpr TokenTapeIterator end() const noexcept {
+    return TokenTapeIterator{this, types_.size()};
+  }
+
+ private:
+  /**
+   * @brief Pushes name token and value attached with `=` if any
+   */
+  constexpr void PushArgument(std::string_view argument) {
+    const bool is_long = argument.starts_with("--");
+    const bool is_short =
+        !is_long && argument.size() > 0 &&
+        argument[0] == constants::kShortPrefix &&
+        !(argument.size() > 1 && argument[1] >= '0' && argument[1] <= '9');
+    if (!is_long && !is_short) {
+      PushValue(argument);
+      return;
+    }
+    const std::size_t prefix = is_long ? 2 : 1;
+    const std::size_t equals = argument.find(constants::kEquals, prefix);
+    Push(Token{argument.substr(prefix, equals - prefix),
+               is_long ? Token::TokenType::LongName
+                       : Token::TokenType::ShortName});
+    if (equals != std::string_view::npos) {
+      PushValue(argument.substr(equals + 1));
+    }
+  }
+
+  /**
+   * @brief Pushes whole value as a single token
+   *
+   * Value wrapped into brackets like `{1, 2}` becomes compound token
+   */
+  constexpr void PushValue(std::string_view value) {
+    const char *begin = value.data();
+    const char *end = begin + value.size();
+    if (!value.empty() && value.front() == constants::kOpenBracket &&
+        details::FindClosingBracket<details::DefaultScanner>(begin + 1, end) ==
+            end - 1) {
+      Push(Token{value.substr(1, value.size() - 2),
+                 Token::TokenType::CompoundName});
+      return;
+    }
+    Push(Token{value, Token::TokenType::Word});
+  }
+
+  constexpr void Push(const Token &token) {
+    auto data = token.GetTokenData();
+    begins_.push_back(data.data());
+    lengths_.push_back(static_cast<std::uint32_t>(data.size()));
+    types_.push_back(token.GetTokenType());
+  }
+
+ private:
+  std::vector<const char *> begins_;
+  std::vector<std::uint32_t> lengths_;
+  std::vector<Token::TokenType> types_;
+  std::string_view source_;
+  int argc_{};
+  const char *const *argv_{};
+};
+
+constexpr Token TokenTapeIterator::operator*() const noexcept {
+  return (*tape_)[index_];
+}
+
+constexpr Token TokenTapeIterator::operator[](
+    difference_type offset) const noexcept {
+  return (*tape_)[index_ + offset];
+}
+
+}  // namespace optica
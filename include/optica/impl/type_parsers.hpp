@@ -1,43 +1,677 @@
 #pragma once
 
-#include <charconv>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
 
+#include "aggregate.hpp"
+#include "compound_tree.hpp"
+#include "enum_traits.hpp"
+#include "error.hpp"
+#include "fixed_string.hpp"
+#include "numeric.hpp"
 #include "token.hpp"
+
 namespace optica {
+/**
+ * @struct TypeParser
+ * @brief Converts token into value of Type
+ *
+ * Specialization provides `static Type ParseValue(const Token&)`.
+ * It may also provide non-throwing
+ * `static ErrorCode TryParseValue(const Token&, Type&)`, which is
+ * preferred by parser when present
+ *
+ * @tparam Type Parsed type
+ */
 template <typename Type>
 struct TypeParser;
 
-template <>
-struct TypeParser<int> {
-  static int ParseValue(const Token& token) {
-    int val{};
-    auto [ptr, ec] = std::from_chars(token.GetTokenData().data(),
-                                     token.GetTokenData().end(), val);
-    return val;
+namespace details {
+/**
+ * @brief Parses value reporting error with \ref ThrowInvalidArgument
+ */
+template <typename T>
+T ParseValueOrThrow(const Token& token) {
+  T value{};
+  if (TypeParser<T>::TryParseValue(token, value) != ErrorCode::Ok) {
+    ThrowInvalidArgument("ERROR: Invalid value");
+  }
+  return value;
+}
+}  // namespace details
+
+/**
+ * @brief Parser of integers
+ *
+ * Values are range checked and may have `0x` or `0b` prefix,
+ * digit separators and size suffix like `4Ki` or `2G`
+ */
+template <details::CheckedInteger T>
+struct TypeParser<T> {
+  static T ParseValue(const Token& token) {
+    return details::ParseValueOrThrow<T>(token);
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token,
+                                           T& value) noexcept {
+    return details::ParseInteger(token.GetTokenData(), value);
   }
 };
 
-template <>
-struct TypeParser<double> {
-  static double ParseValue(const Token& token) {
-    double val{};
-    auto [ptr, ec] = std::from_chars(token.GetTokenData().data(),
-                                     token.GetTokenData().end(), val);
-    return val;
+/**
+ * @brief Parser of floating point numbers
+ *
+ * Values are range checked and may have digit separators and size suffix
+ */
+template <std::floating_point T>
+struct TypeParser<T> {
+  static T ParseValue(const Token& token) {
+    return details::ParseValueOrThrow<T>(token);
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token,
+                                           T& value) noexcept {
+    return details::ParseFloating(token.GetTokenData(), value);
+  }
+};
+
+/**
+ * @brief Parser of durations with unit suffix like `250ms` or `2h`
+ */
+template <typename Rep, typename Period>
+struct TypeParser<std::chrono::duration<Rep, Period>> {
+  using DurationType = std::chrono::duration<Rep, Period>;
+
+  static DurationType ParseValue(const Token& token) {
+    return details::ParseValueOrThrow<DurationType>(token);
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token,
+                                           DurationType& value) noexcept {
+    return details::ParseDuration(token.GetTokenData(), value);
+  }
+};
+
+/**
+ * @brief Parser of enumerations named by \ref EnumTraits
+ *
+ * Name is looked up with perfect hash built in compile time
+ */
+template <NamedEnum Enum>
+struct TypeParser<Enum> {
+  static Enum ParseValue(const Token& token) {
+    return details::ParseValueOrThrow<Enum>(token);
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token,
+                                           Enum& value) noexcept {
+    using Table = details::EnumTable<Enum>;
+    const std::size_t index = Table::FindByName(token.GetTokenData());
+    if (index == Table::kSize) {
+      return ErrorCode::InvalidValue;
+    }
+    value = Table::kNames[index].value;
+    return ErrorCode::Ok;
+  }
+};
+
+/**
+ * @brief Parser of strings with any allocator
+ *
+ * TryParseValue assigns into existing string keeping its allocator,
+ * so std::pmr::string values stay in their memory resource
+ */
+template <typename Allocator>
+struct TypeParser<std::basic_string<char, std::char_traits<char>, Allocator>> {
+  using StringType =
+      std::basic_string<char, std::char_traits<char>, Allocator>;
+
+  static StringType ParseValue(const Token& token) {
+    return StringType(token.GetTokenData());
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token,
+                                           StringType& value) {
+    value.assign(token.GetTokenData());
+    return ErrorCode::Ok;
   }
 };
 
+/**
+ * @brief Parser of borrowed strings
+ *
+ * Value is a view into parsed input or argv without any copy,
+ * so it's valid only while the input is alive
+ */
 template <>
-struct TypeParser<std::string> {
-  static std::string ParseValue(const Token& token) {
-    return std::string(token.GetTokenData());
+struct TypeParser<std::string_view> {
+  static std::string_view ParseValue(const Token& token) noexcept {
+    return token.GetTokenData();
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token,
+                                           std::string_view& value) noexcept {
+    value = token.GetTokenData();
+    return ErrorCode::Ok;
+  }
+};
+
+/**
+ * @brief Parser of inline strings
+ *
+ * Value is copied into inline storage, longer value is rejected with
+ * ErrorCode::StringTooLong instead of allocating
+ */
+template <std::size_t N>
+struct TypeParser<InlineString<N>> {
+  static InlineString<N> ParseValue(const Token& token) {
+    return details::ParseValueOrThrow<InlineString<N>>(token);
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token,
+                                           InlineString<N>& value) noexcept {
+    return value.TryAssign(token.GetTokenData()) ? ErrorCode::Ok
+                                                 : ErrorCode::StringTooLong;
   }
 };
 
+namespace details {
+/**
+ * @brief Decodes value with TypeParser
+ *
+ * Uses TryParseValue when TypeParser provides it and ParseValue otherwise
+ *
+ * @param token Token with value
+ * @param value Decoded value
+ * @return ErrorCode
+ */
+template <typename T>
+constexpr ErrorCode DecodeValue(const Token& token, T& value) {
+  if constexpr (requires {
+                  {
+                    TypeParser<T>::TryParseValue(token, value)
+                  } -> std::same_as<ErrorCode>;
+                }) {
+    return TypeParser<T>::TryParseValue(token, value);
+  } else {
+    value = TypeParser<T>::ParseValue(token);
+    return ErrorCode::Ok;
+  }
+}
+
+/**
+ * @brief Decodes comma separated integers in a single pass
+ *
+ * Plain decimal units like `0,1,2` are converted by
+ * \ref ScanShortDecimal right where digits end, so the list is scanned
+ * once and is never split into units. Units with sign, prefix,
+ * separators, suffix or spaces fall back to \ref ParseInteger.
+ * Units are the ones \ref UnitCursor walks
+ *
+ * @param list Units of non-empty word token
+ * @param out Destination of values
+ * @param capacity Number of values fitting into destination
+ * @param decoded Number of successfully decoded values
+ * @return ErrorCode, ErrorCode::TooManyUnits if list doesn't fit
+ */
+template <CheckedInteger T>
+constexpr ErrorCode DecodeIntegerList(std::string_view list, T* out,
+                                      std::size_t capacity,
+                                      std::size_t& decoded) noexcept {
+  const char* begin = list.data();
+  const char* end = begin + list.size();
+  std::size_t pos = 0;
+  decoded = 0;
+  while (true) {
+    const std::size_t first = pos;
+    std::uint64_t magnitude = 0;
+    const bool plain =
+        ScanShortDecimal(list, pos, magnitude) != 0 &&
+        (pos == list.size() || list[pos] == constants::kComma);
+    std::string_view unit;
+    if (!plain) {
+      const char* comma =
+          DefaultScanner::Find(begin + first, end, constants::kComma);
+      const char* unit_begin = begin + first;
+      const char* unit_end = comma;
+      while (unit_begin != unit_end && *unit_begin == constants::kSpace) {
+        ++unit_begin;
+      }
+      while (unit_end != unit_begin && *(unit_end - 1) == constants::kSpace) {
+        --unit_end;
+      }
+      // Blank unit after the last comma is not a value
+      if (unit_begin == unit_end && comma == end) {
+        return ErrorCode::Ok;
+      }
+      unit = std::string_view(unit_begin, unit_end);
+      pos = static_cast<std::size_t>(comma - begin);
+    }
+    if (decoded == capacity) {
+      return ErrorCode::TooManyUnits;
+    }
+    const ErrorCode code = plain
+                               ? NarrowInteger(false, magnitude, out[decoded])
+                               : ParseInteger(unit, out[decoded]);
+    if (code != ErrorCode::Ok) {
+      return code;
+    }
+    ++decoded;
+    if (pos == list.size() || ++pos == list.size()) {
+      return ErrorCode::Ok;
+    }
+  }
+}
+
+/**
+ * @brief Decodes consecutive values into contiguous destination
+ *
+ * Values are taken from tokens in place without building
+ * intermediate strings. Integers are decoded token by token with
+ * \ref DecodeIntegerList, so a long list in one program argument
+ * is scanned once
+ *
+ * @param cursor \ref ValueCursor positioned before the first value
+ * @param out Destination of values
+ * @param count Number of values
+ * @param decoded Number of successfully decoded and accepted values
+ * @param check Predicate accepting decoded value, rejected one is
+ * reported as ErrorCode::UnexpectedVariant
+ * @return ErrorCode of the first invalid value or ErrorCode::Ok
+ */
+template <typename Cursor, typename T, typename Check>
+constexpr ErrorCode DecodeValues(Cursor& cursor, T* out, std::size_t count,
+                                 std::size_t& decoded, const Check& check) {
+  Token token;
+  if constexpr (CheckedInteger<T>) {
+    for (decoded = 0; decoded < count && cursor.NextToken(token);) {
+      std::size_t size = 0;
+      ErrorCode code = ErrorCode::Ok;
+      if (token.GetTokenType() == Token::TokenType::Word &&
+          !token.GetTokenData().empty()) {
+        code = DecodeIntegerList(token.GetTokenData(), out + decoded,
+                                 count - decoded, size);
+      } else {
+        code = DecodeValue(token, out[decoded]);
+        size = code == ErrorCode::Ok ? 1 : 0;
+      }
+      for (const std::size_t last = decoded + size; decoded != last;
+           ++decoded) {
+        if (!check(out[decoded])) {
+          return ErrorCode::UnexpectedVariant;
+        }
+      }
+      if (code != ErrorCode::Ok) {
+        return code;
+      }
+    }
+  } else {
+    for (decoded = 0; decoded < count && cursor.Next(token); ++decoded) {
+      if (auto code = DecodeValue(token, out[decoded]);
+          code != ErrorCode::Ok) {
+        return code;
+      }
+      if (!check(out[decoded])) {
+        return ErrorCode::UnexpectedVariant;
+      }
+    }
+  }
+  return decoded == count ? ErrorCode::Ok : ErrorCode::NotEnoughValues;
+}
+
+/**
+ * @brief Number of \ref CompoundTree nodes needed to decode T
+ *
+ * Tree of exactly this capacity is built, so compound token with more
+ * units than T has is rejected as soon as tree is full
+ */
+template <typename T>
+inline constexpr std::size_t kCompoundNodes = 1;
+
+template <typename T, std::size_t N>
+inline constexpr std::size_t kCompoundNodes<std::array<T, N>> =
+    1 + N * kCompoundNodes<T>;
+
+template <DecodableAggregate T>
+inline constexpr std::size_t kCompoundNodes<T> =
+    []<typename... Fields>(std::tuple<Fields&...>*) {
+      return 1 + (kCompoundNodes<std::remove_cv_t<Fields>> + ...);
+    }(static_cast<decltype(TieFields(std::declval<T&>()))*>(nullptr));
+
+template <typename... Ts>
+inline constexpr std::size_t kCompoundNodes<std::tuple<Ts...>> =
+    1 + (kCompoundNodes<Ts> + ... + 0);
+
+template <typename First, typename Second>
+inline constexpr std::size_t kCompoundNodes<std::pair<First, Second>> =
+    1 + kCompoundNodes<First> + kCompoundNodes<Second>;
+
+template <typename T>
+inline constexpr std::size_t kCompoundNodes<std::optional<T>> =
+    kCompoundNodes<T>;
+
+template <typename... Ts>
+inline constexpr std::size_t kCompoundNodes<std::variant<Ts...>> =
+    std::max({kCompoundNodes<Ts>...});
+
+/**
+ * @brief Get relative cost of failed attempt to decode T
+ *
+ * Numbers are rejected by the first symbol, compound values need tree
+ * walk, strings always succeed so they are tried last
+ */
+template <typename T>
+constexpr int GetDecodeCost() noexcept {
+  if constexpr (std::is_integral_v<T>) {
+    return 0;
+  } else if constexpr (std::is_enum_v<T>) {
+    return 1;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return 2;
+  } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+    return 5;
+  } else if constexpr (kCompoundNodes<T> > 1) {
+    return 4;
+  } else {
+    return 3;
+  }
+}
+
+/**
+ * @brief Decodes value from node of \ref CompoundTree
+ *
+ * Uses TryParseNode when TypeParser provides it, so nested values are
+ * decoded from already built tree. Otherwise node is decoded as token
+ *
+ * @param node Node with value
+ * @param value Decoded value
+ * @return ErrorCode
+ */
+template <typename T>
+constexpr ErrorCode DecodeNode(CompoundNode node, T& value) {
+  if constexpr (requires {
+                  {
+                    TypeParser<T>::TryParseNode(node, value)
+                  } -> std::same_as<ErrorCode>;
+                }) {
+    return TypeParser<T>::TryParseNode(node, value);
+  } else {
+    return DecodeValue(node.GetToken(), value);
+  }
+}
+
+/**
+ * @brief Checks if node has exactly size children
+ */
+constexpr ErrorCode CheckChildren(CompoundNode node,
+                                  std::size_t size) noexcept {
+  if (node.GetSize() < size) {
+    return ErrorCode::NotEnoughValues;
+  }
+  return node.GetSize() > size ? ErrorCode::TooManyUnits : ErrorCode::Ok;
+}
+
+/**
+ * @brief Decodes children of node into values in order
+ *
+ * @param node Node with children
+ * @param values Decoded values, one per child
+ * @return ErrorCode
+ */
+template <typename... Ts>
+constexpr ErrorCode DecodeChildren(CompoundNode node, Ts&... values) {
+  if (auto code = CheckChildren(node, sizeof...(Ts)); code != ErrorCode::Ok) {
+    return code;
+  }
+  ErrorCode code = ErrorCode::Ok;
+  CompoundNode child = node.GetFirstChild();
+  auto decode = [&](auto& value) {
+    code = DecodeNode(child, value);
+    if (child.HasNext()) {
+      child = child.GetNext();
+    }
+    return code == ErrorCode::Ok;
+  };
+  (decode(values) && ...);
+  return code;
+}
+
+/**
+ * @brief Decodes compound token into value in one pass
+ *
+ * Tree of units is built on stack, then value is decoded from its root
+ *
+ * @param token Token with value, outer brackets already dropped
+ * @param value Decoded value
+ * @return ErrorCode
+ */
+template <typename T>
+constexpr ErrorCode DecodeCompound(const Token& token, T& value) {
+  CompoundTree<kCompoundNodes<T>> tree;
+  if (auto code = tree.Build(token.GetTokenData()); code != ErrorCode::Ok) {
+    return code;
+  }
+  return TypeParser<T>::TryParseNode(tree.GetRoot(), value);
+}
+}  // namespace details
+
+/**
+ * @brief Parser of arrays from compound token like `{10, 20}`
+ *
+ * Array must get exactly N units
+ */
 template <typename T, std::size_t N>
 struct TypeParser<std::array<T, N>> {
+  using ArrayType = std::array<T, N>;
+
+  static ArrayType ParseValue(const Token& token) {
+    return details::ParseValueOrThrow<ArrayType>(token);
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token,
+                                           ArrayType& value) {
+    return details::DecodeCompound(token, value);
+  }
+
+  static constexpr ErrorCode TryParseNode(CompoundNode node,
+                                          ArrayType& value) {
+    if (auto code = details::CheckChildren(node, N); code != ErrorCode::Ok) {
+      return code;
+    }
+    CompoundNode child = node.GetFirstChild();
+    for (std::size_t i = 0; i < N; ++i) {
+      if (auto code = details::DecodeNode(child, value[i]);
+          code != ErrorCode::Ok) {
+        return code;
+      }
+      if (child.HasNext()) {
+        child = child.GetNext();
+      }
+    }
+    return ErrorCode::Ok;
+  }
+};
+
+/**
+ * @brief Parser of aggregates from compound token like `{42, Dmitrii}`
+ *
+ * Fields are found in compile time and decoded in declaration order,
+ * so no explicit specialization is needed. Nested values like
+ * `{eu, {10, 20}}` are decoded from \ref CompoundTree built in one pass.
+ * Explicit specialization still takes precedence
+ */
+template <details::DecodableAggregate T>
+struct TypeParser<T> {
   static T ParseValue(const Token& token) {
-    return TypeParser<T>::ParseValue(token);
+    return details::ParseValueOrThrow<T>(token);
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token, T& value) {
+    return details::DecodeCompound(token, value);
+  }
+
+  static constexpr ErrorCode TryParseNode(CompoundNode node, T& value) {
+    return std::apply(
+        [&](auto&... fields) {
+          return details::DecodeChildren(node, fields...);
+        },
+        details::TieFields(value));
+  }
+};
+
+/**
+ * @brief Parser of tuples from compound token like `{cpu, 4, 0.5}`
+ *
+ * Elements are decoded in place by unrolled fold over the elements
+ */
+template <typename... Ts>
+struct TypeParser<std::tuple<Ts...>> {
+  using TupleType = std::tuple<Ts...>;
+
+  static TupleType ParseValue(const Token& token) {
+    return details::ParseValueOrThrow<TupleType>(token);
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token,
+                                           TupleType& value) {
+    return details::DecodeCompound(token, value);
+  }
+
+  static constexpr ErrorCode TryParseNode(CompoundNode node,
+                                          TupleType& value) {
+    return std::apply(
+        [&](auto&... elements) {
+          return details::DecodeChildren(node, elements...);
+        },
+        value);
+  }
+};
+
+/**
+ * @brief Parser of pairs from compound token like `{cpu, 4}`
+ */
+template <typename First, typename Second>
+struct TypeParser<std::pair<First, Second>> {
+  using PairType = std::pair<First, Second>;
+
+  static PairType ParseValue(const Token& token) {
+    return details::ParseValueOrThrow<PairType>(token);
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token,
+                                           PairType& value) {
+    return details::DecodeCompound(token, value);
+  }
+
+  static constexpr ErrorCode TryParseNode(CompoundNode node,
+                                          PairType& value) {
+    return details::DecodeChildren(node, value.first, value.second);
+  }
+};
+
+/**
+ * @brief Parser of optional values
+ *
+ * Empty unit like the middle one in `{1, , 3}` leaves value empty
+ */
+template <typename T>
+struct TypeParser<std::optional<T>> {
+  using OptionalType = std::optional<T>;
+
+  static OptionalType ParseValue(const Token& token) {
+    return details::ParseValueOrThrow<OptionalType>(token);
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token,
+                                           OptionalType& value) {
+    if (token.GetTokenData().empty()) {
+      value.reset();
+      return ErrorCode::Ok;
+    }
+    return details::DecodeValue(token, value.emplace());
+  }
+
+  static constexpr ErrorCode TryParseNode(CompoundNode node,
+                                          OptionalType& value) {
+    if (!node.IsCompound() && node.GetToken().GetTokenData().empty()) {
+      value.reset();
+      return ErrorCode::Ok;
+    }
+    return details::DecodeNode(node, value.emplace());
+  }
+};
+
+/**
+ * @brief Parser of values which may have one of several types
+ *
+ * Alternatives are tried from the cheapest to reject, see
+ * \ref details::GetDecodeCost, so `int` is tried before `std::string` no
+ * matter the order of alternatives. First decoded alternative is kept
+ */
+template <typename... Ts>
+struct TypeParser<std::variant<Ts...>> {
+  using VariantType = std::variant<Ts...>;
+
+  static VariantType ParseValue(const Token& token) {
+    return details::ParseValueOrThrow<VariantType>(token);
+  }
+
+  static constexpr ErrorCode TryParseValue(const Token& token,
+                                           VariantType& value) {
+    if constexpr (details::kCompoundNodes<VariantType> > 1) {
+      return details::DecodeCompound(token, value);
+    } else {
+      return TryAlternatives(value, [&](auto& alternative) {
+        return details::DecodeValue(token, alternative);
+      });
+    }
+  }
+
+  static constexpr ErrorCode TryParseNode(CompoundNode node,
+                                          VariantType& value) {
+    return TryAlternatives(value, [&](auto& alternative) {
+      return details::DecodeNode(node, alternative);
+    });
+  }
+
+ private:
+  static constexpr auto kOrder = [] {
+    std::array<std::size_t, sizeof...(Ts)> order{};
+    constexpr std::array<int, sizeof...(Ts)> costs = {
+        details::GetDecodeCost<Ts>()...};
+    // Insertion sort keeps declaration order of alternatives of same cost
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      std::size_t j = i;
+      for (; j > 0 && costs[order[j - 1]] > costs[i]; --j) {
+        order[j] = order[j - 1];
+      }
+      order[j] = i;
+    }
+    return order;
+  }();
+
+  template <typename Decode>
+  static constexpr ErrorCode TryAlternatives(VariantType& value,
+                                             Decode decode) {
+    const bool decoded = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return (TryAlternative<kOrder[Is]>(value, decode) || ...);
+    }(std::make_index_sequence<sizeof...(Ts)>{});
+    return decoded ? ErrorCode::Ok : ErrorCode::InvalidValue;
+  }
+
+  template <std::size_t I, typename Decode>
+  static constexpr bool TryAlternative(VariantType& value, Decode& decode) {
+    return decode(value.template emplace<I>()) == ErrorCode::Ok;
   }
 };
 }  // namespace optica
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "aggregate.hpp"
+#include "enum_traits.hpp"
+#include "fixed_string.hpp"
+#include "option.hpp"
+
+namespace optica::details {
+
+/// Width of usage text
+inline constexpr std::size_t kUsageWidth = 80;
+
+/// Widest column of names, description of longer name starts on next line
+inline constexpr std::size_t kUsageNameWidth = 32;
+
+template <typename T>
+struct is_duration : std::false_type {};
+
+template <typename Rep, typename Period>
+struct is_duration<std::chrono::duration<Rep, Period>> : std::true_type {};
+
+/**
+ * @brief Appends placeholder of value like `<int>` or `<local|replicated>`
+ *
+ * @param out Usage text
+ */
+template <typename T>
+constexpr void AppendValueHint(std::string &out) {
+  if constexpr (NamedEnum<T>) {
+    out += '<';
+    const auto &names = EnumTraits<T>::kNames;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      out += i == 0 ? "" : "|";
+      out += names[i].name;
+    }
+    out += '>';
+  } else if constexpr (is_duration<T>::value) {
+    out += "<duration>";
+  } else if constexpr (std::integral<T>) {
+    out += "<int>";
+  } else if constexpr (std::floating_point<T>) {
+    out += "<float>";
+  } else if constexpr (std::is_convertible_v<T, std::string_view>) {
+    out += "<string>";
+  } else if constexpr (is_std_array<T>::value) {
+    AppendValueHint<typename T::value_type>(out);
+    out += ",...";
+  } else {
+    out += "<value>";
+  }
+}
+
+/**
+ * @brief Left column of option like `-t, --threads <int>`
+ */
+template <OptionType Opt>
+constexpr std::string GetUsageName() {
+  using ValueType = decltype(std::declval<Opt>().GetValueType());
+  std::string name = "  ";
+  if constexpr (requires { Opt::GetShortName(); }) {
+    name += '-';
+    name += std::string_view(Opt::GetShortName());
+    name += ", ";
+  } else {
+    name += "    ";
+  }
+  name += "--";
+  name += std::string_view(Opt::GetName());
+  if constexpr (!Opt::IsFlag()) {
+    name += ' ';
+    if constexpr (requires { Opt::GetArityType(); }) {
+      // Every token after name is a separate value
+      AppendValueHint<typename ValueType::value_type>(name);
+      name += "...";
+    } else {
+      AppendValueHint<ValueType>(name);
+    }
+  }
+  return name;
+}
+
+/**
+ * @brief Right column of option, its description and marks
+ */
+template <OptionType Opt>
+constexpr std::string GetUsageDescription() {
+  std::string description;
+  if constexpr (requires { Opt::GetDescription(); }) {
+    description += std::string_view(Opt::GetDescription());
+  }
+  if constexpr (Opt::IsRequired()) {
+    description += description.empty() ? "(required)" : " (required)";
+  }
+  return description;
+}
+
+/**
+ * @brief Appends text wrapped by words at \ref kUsageWidth
+ *
+ * @param out Usage text, its last line is filled up to indent
+ * @param text Text to wrap
+ * @param indent Column where every line of text starts
+ */
+constexpr void AppendWrapped(std::string &out, std::string_view text,
+                             std::size_t indent) {
+  std::size_t column = indent;
+  bool line_start = true;
+  while (true) {
+    const std::size_t begin = text.find_first_not_of(' ');
+    if (begin == std::string_view::npos) {
+      break;
+    }
+    text.remove_prefix(begin);
+    const std::string_view word = text.substr(0, text.find(' '));
+    text.remove_prefix(word.size());
+
+    // Words are never broken, so too long word sticks out of the line
+    if (!line_start && column + 1 + word.size() > kUsageWidth) {
+      out += '\n';
+      out.append(indent, ' ');
+      column = indent;
+      line_start = true;
+    }
+    if (!line_start) {
+      out += ' ';
+      ++column;
+    }
+    out += word;
+    column += word.size();
+    line_start = false;
+  }
+  out += '\n';
+}
+
+/**
+ * @brief Appends line of option with description starting at column
+ */
+template <OptionType Opt>
+constexpr void AppendOptionUsage(std::string &out, std::size_t column) {
+  const std::string name = GetUsageName<Opt>();
+  const std::string description = GetUsageDescription<Opt>();
+  out += name;
+  if (description.empty()) {
+    out += '\n';
+    return;
+  }
+  if (name.size() + 2 > column) {
+    out += '\n';
+    out.append(column, ' ');
+  } else {
+    out.append(column - name.size(), ' ');
+  }
+  AppendWrapped(out, description, column);
+}
+
+/**
+ * @brief Builds usage text of options
+ *
+ * Names are aligned in the left column and descriptions are wrapped
+ * in the right one
+ *
+ * @return std::string usage text
+ */
+template <OptionType... Opts>
+constexpr std::string BuildUsage() {
+  std::size_t column = 0;
+  (
+      [&] {
+        const std::size_t size = GetUsageName<Opts>().size();
+        if (size <= kUsageNameWidth) {
+          column = std::max(column, size);
+        }
+      }(),
+      ...);
+  column += 2;
+
+  std::string usage = "Options:\n";
+  (AppendOptionUsage<Opts>(usage, column), ...);
+  return usage;
+}
+
+template <OptionType... Opts>
+inline constexpr std::size_t kUsageSize = BuildUsage<Opts...>().size();
+
+/**
+ * @brief Usage text of options built in compile time
+ *
+ * Text is a constant, so printing it is a single write
+ */
+template <OptionType... Opts>
+inline constexpr FixedString<kUsageSize<Opts...>> kUsage = [] {
+  std::array<char, kUsageSize<Opts...>> data{};
+  const std::string usage = BuildUsage<Opts...>();
+  std::copy(usage.begin(), usage.end(), data.begin());
+  return FixedString<kUsageSize<Opts...>>(data);
+}();
+
+}  // namespace optica::details
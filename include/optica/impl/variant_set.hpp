@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+#include "bit_mask.hpp"
+#include "perfect_hash.hpp"
+
+namespace optica::details {
+
+/**
+ * @class VariantSet
+ * @brief Set of allowed values with constant time membership check
+ *
+ * Generic set compares value with every variant. Integral and string
+ * sets are specialized
+ *
+ * @tparam T Type of values
+ * @tparam N Number of variants
+ */
+template <typename T, std::size_t N>
+class VariantSet {
+ public:
+  constexpr explicit VariantSet(const std::array<T, N> &variants)
+      : variants_(variants) {}
+
+  [[nodiscard]] constexpr bool Contains(const T &value) const noexcept {
+    return std::find(variants_.begin(), variants_.end(), value) !=
+           variants_.end();
+  }
+
+ private:
+  std::array<T, N> variants_;
+};
+
+/**
+ * @brief Set of integers
+ *
+ * Variants within kWindow of the smallest one are kept in a bitset, so
+ * check is a single bit test. Wider sets are sorted and searched with
+ * branchless binary search. Variants are constructor arguments, so the
+ * structure is picked when set is built and only that one is stored.
+ * Values of one byte types always fit the window, so their sets are
+ * bitsets without any choice
+ */
+template <std::integral T, std::size_t N>
+  requires(!std::is_same_v<T, bool>)
+class VariantSet<T, N> {
+ public:
+  static constexpr std::size_t kWindow = 256;
+  static constexpr bool kAlwaysDense = sizeof(T) == 1;
+
+  constexpr explicit VariantSet(const std::array<T, N> &variants) {
+    std::array<T, N> sorted = variants;
+    std::sort(sorted.begin(), sorted.end());
+    base_ = sorted.front();
+    dense_ = kAlwaysDense || GetOffset(sorted.back()) < kWindow;
+    if (dense_) {
+      for (T variant : sorted) {
+        storage_.bits.Set(GetOffset(variant));
+      }
+    } else {
+      std::construct_at(&storage_.sorted, sorted);
+    }
+  }
+
+  [[nodiscard]] constexpr bool Contains(T value) const noexcept {
+    if (kAlwaysDense || dense_) {
+      const std::uint64_t offset = GetOffset(value);
+      return offset < kWindow && storage_.bits.Test(offset);
+    }
+    const T *base = storage_.sorted.data();
+    std::size_t size = N;
+    while (size > 1) {
+      const std::size_t half = size / 2;
+      // Compiled into conditional move, so search has no branches
+      base = base[half] <= value ? base + half : base;
+      size -= half;
+    }
+    return *base == value;
+  }
+
+  /**
+   * @brief Checks if variants are kept in bitset
+   */
+  [[nodiscard]] constexpr bool IsDense() const noexcept {
+    return kAlwaysDense || dense_;
+  }
+
+ private:
+  union Storage {
+    constexpr Storage() noexcept : bits() {}
+
+    BitMask<kWindow> bits;
+    std::array<T, N> sorted;
+  };
+
+  constexpr std::uint64_t GetOffset(T value) const noexcept {
+    using Unsigned = std::make_unsigned_t<T>;
+    return static_cast<Unsigned>(static_cast<Unsigned>(value) -
+                                 static_cast<Unsigned>(base_));
+  }
+
+  Storage storage_;
+  T base_{};
+  bool dense_{};
+};
+
+/**
+ * @brief Set of strings
+ *
+ * Variants are placed into perfect hash, so check is one hash and
+ * one comparison
+ */
+template <std::size_t N>
+class VariantSet<std::string_view, N> {
+ public:
+  constexpr explicit VariantSet(
+      const std::array<std::string_view, N> &variants)
+      : variants_(variants), hash_(GetHashes(variants)) {}
+
+  [[nodiscard]] constexpr bool Contains(
+      std::string_view value) const noexcept {
+    const std::size_t index = hash_.Find(HashString(value));
+    return index != N && variants_[index] == value;
+  }
+
+ private:
+  static constexpr std::array<std::uint64_t, N> GetHashes(
+      const std::array<std::string_view, N> &variants) noexcept {
+    std::array<std::uint64_t, N> hashes{};
+    for (std::size_t i = 0; i < N; ++i) {
+      hashes[i] = HashString(variants[i]);
+    }
+    return hashes;
+  }
+
+  std::array<std::string_view, N> variants_;
+  PerfectHash<N> hash_;
+};
+
+}  // namespace optica::details
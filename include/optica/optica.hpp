@@ -7,10 +7,22 @@
  */
 namespace optica {}
 
+#include "impl/aggregate.hpp"
+#include "impl/bit_mask.hpp"
+#include "impl/compound_tree.hpp"
+#include "impl/enum_traits.hpp"
+#include "impl/error.hpp"
 #include "impl/fixed_string.hpp"
+#include "impl/numeric.hpp"
 #include "impl/option.hpp"
 #include "impl/option_builder.hpp"
+#include "impl/parse_result.hpp"
 #include "impl/parser.hpp"
+#include "impl/perfect_hash.hpp"
 #include "impl/properties.hpp"
+#include "impl/scanner.hpp"
 #include "impl/token.hpp"
+#include "impl/token_tape.hpp"
 #include "impl/type_parsers.hpp"
+#include "impl/usage.hpp"
+#include "impl/variant_set.hpp"
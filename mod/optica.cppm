@@ -5,13 +5,31 @@ module;
 export module optica;
 
 export namespace optica {
+using optica::Any;
+using optica::Arity;
+using optica::AtLeast;
+using optica::AtMost;
+using optica::Between;
 using optica::Bind;
 using optica::CreateOption;
 using optica::DefaultValue;
+using optica::Description;
+using optica::EnumEntry;
+using optica::EnumName;
+using optica::EnumTraits;
+using optica::ErrorCode;
+using optica::Exact;
+using optica::ExclusiveGroup;
 using optica::Flag;
+using optica::InlineString;
 using optica::Opt;
+using optica::ParseError;
+using optica::Parser;
 using optica::Required;
+using optica::Requires;
 using optica::ShortName;
+using optica::TokenTape;
 using optica::Variant;
+using optica::to_string;
 using optica::operator|;
 }  // namespace optica
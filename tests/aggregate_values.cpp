@@ -0,0 +1,74 @@
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <optica/optica.hpp>
+#include <string>
+#include <string_view>
+
+namespace {
+struct Endpoint {
+  std::string host;
+  std::uint16_t port{};
+  std::chrono::milliseconds timeout{};
+};
+
+struct Point {
+  int x{};
+  int y{};
+};
+
+struct Route {
+  std::string_view zone;
+  Point origin;
+};
+}  // namespace
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"endpoint", Endpoint>() | optica::ShortName<"e">(),
+    optica::Opt<"point", Point>());
+
+TEST_CASE("Aggregate fields are counted in compile time", "[aggregate]") {
+  STATIC_REQUIRE(optica::details::CountFields<Endpoint>() == 3);
+  STATIC_REQUIRE(optica::details::CountFields<Point>() == 2);
+  STATIC_REQUIRE(optica::details::DecodableAggregate<Point>);
+  STATIC_REQUIRE_FALSE(
+      optica::details::DecodableAggregate<std::array<int, 2>>);
+
+  // Views in fields point into input, so result can't outlive it
+  STATIC_REQUIRE(optica::details::is_borrowed_value<Route>::value);
+  STATIC_REQUIRE_FALSE(optica::details::is_borrowed_value<Endpoint>::value);
+
+  constexpr Point point = [] {
+    Point value;
+    optica::TypeParser<Point>::TryParseValue(
+        optica::Token{"3, -4", optica::Token::TokenType::CompoundName},
+        value);
+    return value;
+  }();
+  STATIC_REQUIRE(point.x == 3);
+  STATIC_REQUIRE(point.y == -4);
+}
+
+TEST_CASE("Aggregate is decoded from compound token", "[aggregate]") {
+  auto result =
+      parser.Parse("--endpoint {db.local, 5432, 250ms} --point={1,2}");
+  auto endpoint = result.Get<"endpoint">().value();
+
+  REQUIRE(endpoint.host == "db.local");
+  REQUIRE(endpoint.port == 5432);
+  REQUIRE(endpoint.timeout == std::chrono::milliseconds{250});
+  REQUIRE(result.Get<"point">().value().x == 1);
+  REQUIRE(result.Get<"point">().value().y == 2);
+}
+
+TEST_CASE("Aggregate reports invalid units", "[aggregate]") {
+  using enum optica::ErrorCode;
+  for (auto [input, code] :
+       {std::pair{"-e {db, 70000, 1s}", OutOfRange},
+        std::pair{"-e {db, 80}", NotEnoughValues},
+        std::pair{"-e {db, 80, 1s, x}", TooManyUnits},
+        std::pair{"--point {1, y}", InvalidValue}}) {
+    auto parsed = parser.TryParse(input);
+    REQUIRE_FALSE(parsed.has_value());
+    REQUIRE(parsed.error().code == code);
+  }
+}
@@ -0,0 +1,62 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"name", std::string>() | optica::ShortName<"n">(),
+    optica::Opt<"day", int>() | optica::ShortName<"d">(),
+    optica::Opt<"week", std::array<std::string, 3>>() |
+        optica::Arity<optica::Exact<3>>());
+
+TEST_CASE("Option can be parsed from argv", "[argv]") {
+  const char* argv[] = {"prog", "--name", "a b", "-d", "3"};
+  auto result = parser.Parse(5, argv);
+
+  REQUIRE(result.Get<"name">().value() == "a b");
+  REQUIRE(result.Get<"day">().value() == 3);
+}
+
+TEST_CASE("Option can be parsed from argv with =", "[argv]") {
+  char name[] = "--name=x y";
+  char week[] = "--week=Mon,Tue,Wed";
+  char* argv[] = {nullptr, name, week};
+  auto result = parser.Parse(3, argv);
+  std::array<std::string, 3> days = {"Mon", "Tue", "Wed"};
+
+  REQUIRE(result.Get<"name">().value() == "x y");
+  REQUIRE_THAT(result.Get<"week">().value(),
+               Catch::Matchers::RangeEquals(days));
+}
+
+TEST_CASE("Argv values keep commas and equals signs", "[argv]") {
+  const char* comma[] = {"prog", "--name", "a,b"};
+  REQUIRE(parser.Parse(3, comma).Get<"name">().value() == "a,b");
+
+  const char* equals[] = {"prog", "-n", "x=1", "--day=4"};
+  auto result = parser.Parse(4, equals);
+  REQUIRE(result.Get<"name">().value() == "x=1");
+  REQUIRE(result.Get<"day">().value() == 4);
+
+  const char* attached[] = {"prog", "--name=k=v,w"};
+  REQUIRE(parser.Parse(2, attached).Get<"name">().value() == "k=v,w");
+
+  // Only lists split values by commas
+  const char* list[] = {"prog", "--week", "Mon,Tue", "Wed"};
+  REQUIRE(parser.Parse(4, list).Get<"week">().value()[2] == "Wed");
+
+  const char* extra[] = {"prog", "--week", "Mon,Tue,Wed,Thu"};
+  auto parsed = parser.TryParse(3, extra);
+  REQUIRE_FALSE(parsed.has_value());
+  REQUIRE(parsed.error().code == optica::ErrorCode::TooManyUnits);
+}
+
+TEST_CASE("Argv tokens point into arguments", "[argv]") {
+  const char* argv[] = {"prog", "--name", "a b", "{1, 2}", ""};
+  optica::TokenTape tape{5, argv};
+
+  REQUIRE(tape.size() == 4);
+  REQUIRE(tape[0].GetTokenData().data() == argv[1] + 2);
+  REQUIRE(tape[1].GetTokenData().data() == argv[2]);
+  REQUIRE(tape[1].GetTokenData() == "a b");
+  REQUIRE(tape[2].GetTokenType() == optica::Token::TokenType::CompoundName);
+  REQUIRE(tape[3] == optica::Token("", optica::Token::TokenType::Word));
+}
@@ -0,0 +1,57 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <string>
+
+namespace {
+int day{};
+std::string name;
+std::array<double, 2> point{};
+bool verbose{};
+}  // namespace
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"day", int>() | optica::ShortName<"d">() | optica::Bind(day),
+    optica::Opt<"name", std::string>() | optica::Bind(name),
+    optica::Opt<"point", std::array<double, 2>>() |
+        optica::Arity<optica::Exact<2>>() | optica::Bind(point),
+    optica::Flag<"verbose">() | optica::ShortName<"v">() |
+        optica::Bind(verbose),
+    optica::Opt<"hour", int>());
+
+using Result = decltype(parser)::ParseResultType;
+
+TEST_CASE("Bound options write into variables", "[bind]") {
+  auto result = parser.Parse("--day 3 --name first --point 0.5,1.5");
+
+  REQUIRE(day == 3);
+  REQUIRE(name == "first");
+  REQUIRE(point[1] == 1.5);
+  REQUIRE(result.Contains<"day">());
+  REQUIRE_FALSE(result.Contains<"verbose">());
+  REQUIRE_FALSE(result.Contains<"hour">());
+
+  parser.Parse("-vd4");
+  REQUIRE(verbose);
+  REQUIRE(day == 4);
+}
+
+TEST_CASE("Bound options take no space in result", "[bind]") {
+  // int of hour and two bytes of presence masks
+  STATIC_REQUIRE(Result::kPackedSize == 8);
+
+  auto result = parser.Parse("--hour 7 --name second");
+  REQUIRE(result.Get<"hour">().value() == 7);
+  REQUIRE(result.Contains<"name">());
+  REQUIRE(name == "second");
+}
+
+TEST_CASE("Bound options report errors", "[bind]") {
+  auto duplicate = parser.TryParse("--day 1 -d 2");
+  REQUIRE_FALSE(duplicate.has_value());
+  REQUIRE(duplicate.error().code == optica::ErrorCode::DuplicateOption);
+
+  auto invalid = parser.TryParse("--point 1,x");
+  REQUIRE_FALSE(invalid.has_value());
+  REQUIRE(invalid.error().code == optica::ErrorCode::InvalidValue);
+  REQUIRE(invalid.error().option_index == 2);
+}
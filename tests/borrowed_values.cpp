@@ -0,0 +1,64 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <string>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"tenant", std::string_view>() | optica::ShortName<"t">(),
+    optica::Opt<"region", std::string_view>(),
+    optica::Opt<"modes", std::array<std::string_view, 2>>() |
+        optica::Arity<optica::Exact<2>>());
+
+constexpr auto owning_parser =
+    optica::Parser(optica::Opt<"tenant", std::string>());
+
+namespace {
+template <typename Parser>
+concept AcceptsTemporary = requires(const Parser& parser) {
+  parser.Parse(std::string("--tenant acme"));
+};
+
+template <typename Parser>
+concept TriesTemporary = requires(const Parser& parser) {
+  parser.TryParse(std::string("--tenant acme"));
+};
+
+bool Inside(std::string_view value, std::string_view input) {
+  return std::less_equal<>{}(input.data(), value.data()) &&
+         std::less_equal<>{}(value.data() + value.size(),
+                             input.data() + input.size());
+}
+}  // namespace
+
+TEST_CASE("String view values point into input", "[borrowed]") {
+  const std::string valid = "--tenant acme --region eu --modes fast,safe";
+  auto result = parser.Parse(valid);
+  auto tenant = result.Get<"tenant">().value();
+  auto modes = result.Get<"modes">().value();
+
+  REQUIRE(tenant == "acme");
+  REQUIRE(Inside(tenant, valid));
+  REQUIRE(result.Get<"region">().value() == "eu");
+  REQUIRE(modes[0] == "fast");
+  REQUIRE(modes[1] == "safe");
+  REQUIRE(Inside(modes[1], valid));
+}
+
+TEST_CASE("String view values point into argv", "[borrowed]") {
+  const char* argv[] = {"prog", "-t", "acme corp", "--region=us"};
+  auto result = parser.Parse(4, argv);
+
+  REQUIRE(result.Get<"tenant">().value().data() == argv[2]);
+  REQUIRE(result.Get<"tenant">().value() == "acme corp");
+  REQUIRE(result.Get<"region">().value() == "us");
+}
+
+TEST_CASE("Borrowing result rejects temporary strings", "[borrowed]") {
+  using Result = decltype(parser)::ParseResultType;
+  using OwningResult = decltype(owning_parser)::ParseResultType;
+  STATIC_REQUIRE(Result::kBorrowsInput);
+  STATIC_REQUIRE_FALSE(OwningResult::kBorrowsInput);
+
+  STATIC_REQUIRE_FALSE(AcceptsTemporary<decltype(parser)>);
+  STATIC_REQUIRE_FALSE(TriesTemporary<decltype(parser)>);
+  STATIC_REQUIRE(AcceptsTemporary<decltype(owning_parser)>);
+}
@@ -0,0 +1,96 @@
+#include <array>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstring>
+#include <optica/optica.hpp>
+#include <string>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"shards", std::array<int, 512>>() |
+        optica::Arity<optica::Exact<512>>(),
+    optica::Opt<"ids", std::array<std::uint64_t, 3>>() |
+        optica::ShortName<"i">() | optica::Arity<optica::Exact<3>>());
+
+namespace {
+std::uint64_t Load(const char* digits) {
+  std::uint64_t chunk;
+  std::memcpy(&chunk, digits, sizeof(chunk));
+  return chunk;
+}
+}  // namespace
+
+TEST_CASE("Eight digits are converted at once", "[bulk]") {
+  REQUIRE(optica::details::IsEightDigits(Load("12345678")));
+  REQUIRE_FALSE(optica::details::IsEightDigits(Load("1234'678")));
+  REQUIRE_FALSE(optica::details::IsEightDigits(Load("1234567:")));
+  REQUIRE(optica::details::ParseEightDigits(Load("12345678")) == 12345678);
+  REQUIRE(optica::details::ParseEightDigits(Load("00000009")) == 9);
+
+  std::uint64_t value{};
+  REQUIRE(optica::details::ParseInteger("1234567890123456789", value) ==
+          optica::ErrorCode::Ok);
+  REQUIRE(value == 1234567890123456789ULL);
+  REQUIRE(optica::details::ParseInteger("12345678'9", value) ==
+          optica::ErrorCode::Ok);
+  REQUIRE(value == 123456789);
+  REQUIRE(optica::details::ParseInteger("99999999999999999999", value) ==
+          optica::ErrorCode::OutOfRange);
+}
+
+TEST_CASE("Long numeric lists are decoded into array", "[bulk]") {
+  std::string command = "--shards ";
+  for (int i = 0; i < 512; ++i) {
+    command += std::to_string(i * 1000) + (i + 1 < 512 ? "," : "");
+  }
+  command += " -i 18446744073709551615,42,0x10";
+  auto result = parser.Parse(command);
+
+  auto shards = result.Get<"shards">().value();
+  REQUIRE(shards[0] == 0);
+  REQUIRE(shards[511] == 511000);
+  REQUIRE(result.Get<"ids">().value()[0] == 18446744073709551615ULL);
+  REQUIRE(result.Get<"ids">().value()[2] == 16);
+}
+
+TEST_CASE("Invalid element of list is reported", "[bulk]") {
+  const std::string command = "-i1,2,x3";
+  auto attached = parser.TryParse(command);
+  REQUIRE_FALSE(attached.has_value());
+  REQUIRE(attached.error().code == optica::ErrorCode::InvalidValue);
+  REQUIRE(attached.error().offset == command.find('x'));
+
+  auto first = parser.TryParse("--ids 1x,2,3");
+  REQUIRE_FALSE(first.has_value());
+  REQUIRE(first.error().offset == 6);
+}
+
+TEST_CASE("Short integers of one argument are decoded in one pass",
+          "[bulk]") {
+  std::array<std::int64_t, 8> values{};
+  std::size_t decoded = 0;
+  REQUIRE(optica::details::DecodeIntegerList(
+              "7,-1, 8 ,0x10,1234567,123456789012,1'000,4Ki,", values.data(),
+              values.size(), decoded) == optica::ErrorCode::Ok);
+  REQUIRE(decoded == 8);
+  REQUIRE(values == std::array<std::int64_t, 8>{7, -1, 8, 16, 1234567,
+                                                123456789012, 1000, 4096});
+
+  REQUIRE(optica::details::DecodeIntegerList("1,2,3", values.data(), 2,
+                                             decoded) ==
+          optica::ErrorCode::TooManyUnits);
+  REQUIRE(optica::details::DecodeIntegerList("1,,3", values.data(), 3,
+                                             decoded) ==
+          optica::ErrorCode::InvalidValue);
+  REQUIRE(decoded == 1);
+  REQUIRE(optica::details::DecodeIntegerList("5,99999999999999999999",
+                                             values.data(), 2, decoded) ==
+          optica::ErrorCode::OutOfRange);
+
+  const char* argv[] = {"prog", "--shards", "0,1,2,3,4,5,6,7,8,9,10,11"};
+  static constexpr auto kShort = optica::Parser(
+      optica::Opt<"shards", std::array<std::uint8_t, 12>>() |
+      optica::Arity<optica::Exact<12>>());
+  auto shards = kShort.Parse(3, argv).Get<"shards">().value();
+  REQUIRE(shards[0] == 0);
+  REQUIRE(shards[11] == 11);
+}
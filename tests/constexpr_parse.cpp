@@ -0,0 +1,76 @@
+#include <array>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <optica/optica.hpp>
+#include <string_view>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"threads", int>() | optica::ShortName<"t">(),
+    optica::Opt<"mode", std::string_view>() | optica::Variant("fast", "safe"),
+    optica::Opt<"ratio", double>() | optica::DefaultValue(1.0),
+    optica::Opt<"timeout", std::chrono::milliseconds>(),
+    optica::Opt<"name", optica::InlineString<8>>(),
+    optica::Opt<"size", std::array<int, 2>>() |
+        optica::Arity<optica::Exact<2>>(),
+    optica::Opt<"verbose", bool>() | optica::ShortName<"v">());
+
+constexpr auto kFastPreset =
+    parser.Parse("-vt8 --mode fast --ratio 2.5e-1 --timeout 2min "
+                 "--name worker --size 640,480");
+constexpr auto kSafePreset = parser.Parse("--mode safe");
+
+TEST_CASE("Presets are parsed in compile time", "[constexpr_parse]") {
+  STATIC_REQUIRE(kFastPreset.Get<"threads">() == 8);
+  STATIC_REQUIRE(kFastPreset.Get<"mode">() == "fast");
+  STATIC_REQUIRE(kFastPreset.Get<"ratio">() == 0.25);
+  STATIC_REQUIRE(kFastPreset.Get<"timeout">() ==
+                 std::chrono::minutes(2));
+  STATIC_REQUIRE(kFastPreset.Get<"name">().value() == "worker");
+  STATIC_REQUIRE(kFastPreset.Get<"size">().value()[1] == 480);
+  STATIC_REQUIRE(kFastPreset.Get<"verbose">() == true);
+
+  STATIC_REQUIRE(kSafePreset.Get<"mode">() == "safe");
+  STATIC_REQUIRE(kSafePreset.Get<"ratio">() == 1.0);
+  STATIC_REQUIRE_FALSE(kSafePreset.Contains<"threads">());
+
+  // Preset is a plain constant, copying it needs no parsing
+  auto preset = kFastPreset;
+  REQUIRE(preset.Get<"threads">() == 8);
+}
+
+TEST_CASE("Bad presets are rejected in compile time", "[constexpr_parse]") {
+  constexpr auto variant = parser.TryParse("--mode slow");
+  STATIC_REQUIRE(variant.error().code == optica::ErrorCode::UnexpectedVariant);
+
+  constexpr auto number = parser.TryParse("--threads 8x");
+  STATIC_REQUIRE(number.error().code == optica::ErrorCode::InvalidValue);
+
+  constexpr auto unknown = parser.TryParse("--thread 8");
+  STATIC_REQUIRE(unknown.error().code == optica::ErrorCode::UnknownArgument);
+  STATIC_REQUIRE(unknown.error().offset == 2);
+
+  constexpr auto name = parser.TryParse("--name very-long-name");
+  STATIC_REQUIRE(name.error().code == optica::ErrorCode::StringTooLong);
+}
+
+TEST_CASE("Floating numbers match in compile time and run time",
+          "[constexpr_parse]") {
+  static constexpr std::array<std::string_view, 6> kInputs = {
+      "--ratio 0.1", "--ratio -3.75", "--ratio 1'000.5",
+      "--ratio 12e-3", "--ratio 9007199254740992", "--ratio 1e22"};
+  constexpr auto kParsed = [] {
+    std::array<double, kInputs.size()> values{};
+    for (std::size_t i = 0; i < kInputs.size(); ++i) {
+      values[i] = *parser.Parse(kInputs[i]).Get<"ratio">();
+    }
+    return values;
+  }();
+  for (std::size_t i = 0; i < kInputs.size(); ++i) {
+    REQUIRE(parser.Parse(kInputs[i]).Get<"ratio">() == kParsed[i]);
+  }
+
+  // Numbers beyond exact fast path are left to std::from_chars
+  constexpr auto large = parser.TryParse("--ratio 1e300");
+  STATIC_REQUIRE(large.error().code == optica::ErrorCode::InvalidValue);
+  REQUIRE(parser.Parse("--ratio 1e300").Get<"ratio">() == 1e300);
+}
@@ -0,0 +1,63 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <string>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"input", std::string>() | optica::ShortName<"i">() |
+        optica::Required(),
+    optica::Opt<"day", int>() | optica::Required(),
+    optica::Flag<"json">() | optica::ExclusiveGroup<"format">(),
+    optica::Flag<"yaml">() | optica::ExclusiveGroup<"format">(),
+    optica::Opt<"user", std::string>() |
+        optica::Requires<"password", "host">(),
+    optica::Opt<"password", std::string>(),
+    optica::Opt<"host", std::string_view>() |
+        optica::DefaultValue(std::string_view("localhost")));
+
+TEST_CASE("Required options must be set", "[constraints]") {
+  REQUIRE(parser.TryParse("-i file --day 3").has_value());
+
+  const std::string input = "--day 3";
+  auto result = parser.TryParse(input);
+  REQUIRE_FALSE(result.has_value());
+  REQUIRE(result.error().code == optica::ErrorCode::MissingRequired);
+  REQUIRE(result.error().option_index == 0);
+  REQUIRE(result.error().offset == input.size());
+
+  REQUIRE_THROWS_WITH(parser.Parse(""),
+                      Catch::Matchers::ContainsSubstring("--input, --day"));
+}
+
+TEST_CASE("Exclusive options can't be met together", "[constraints]") {
+  REQUIRE(parser.TryParse("-i a --day 1 --json").has_value());
+
+  auto result = parser.TryParse("-i a --day 1 --json --yaml");
+  REQUIRE_FALSE(result.has_value());
+  REQUIRE(result.error().code == optica::ErrorCode::ExclusiveOptions);
+  REQUIRE(result.error().option_index == 3);
+  REQUIRE_THROWS_WITH(parser.Parse("-i a --day 1 --yaml --json"),
+                      Catch::Matchers::ContainsSubstring("--json, --yaml"));
+
+  // One option of each group passes the combined mask check
+  constexpr auto kGroups = optica::Parser(
+      optica::Flag<"json">() | optica::ExclusiveGroup<"format">(),
+      optica::Flag<"yaml">() | optica::ExclusiveGroup<"format">(),
+      optica::Flag<"fast">() | optica::ExclusiveGroup<"speed">(),
+      optica::Flag<"slow">() | optica::ExclusiveGroup<"speed">());
+  REQUIRE(kGroups.TryParse("--json --slow").has_value());
+  auto speed = kGroups.TryParse("--yaml --fast --slow");
+  REQUIRE_FALSE(speed.has_value());
+  REQUIRE(speed.error().option_index == 3);
+}
+
+TEST_CASE("Option requires other options", "[constraints]") {
+  // host has default value
+  REQUIRE(parser.TryParse("-i a --day 1 --user me --password pw"));
+
+  auto result = parser.TryParse("-i a --day 1 --user me");
+  REQUIRE_FALSE(result.has_value());
+  REQUIRE(result.error().code == optica::ErrorCode::MissingDependency);
+  REQUIRE(result.error().option_index == 4);
+  REQUIRE_THROWS_WITH(parser.Parse("-i a --day 1 --user me"),
+                      Catch::Matchers::EndsWith(": --password"));
+}
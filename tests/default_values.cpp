@@ -0,0 +1,67 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <string>
+
+namespace {
+int retries{};
+}  // namespace
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"day", int>() | optica::ShortName<"d">() |
+        optica::DefaultValue(7),
+    optica::Opt<"ratio", double>() | optica::DefaultValue(0.5),
+    optica::Opt<"retries", int>() | optica::DefaultValue(3) |
+        optica::Bind(retries),
+    optica::Opt<"hour", int>());
+
+using Result = decltype(parser)::ParseResultType;
+
+TEST_CASE("Defaults are seen by Get", "[defaults]") {
+  STATIC_REQUIRE(Result::kTriviallyCopyable);
+
+  auto result = parser.Parse("--hour 5");
+  REQUIRE(result.Get<"day">().value() == 7);
+  REQUIRE(result.Get<"ratio">().value() == 0.5);
+  REQUIRE(result.Get<"hour">().value() == 5);
+  REQUIRE(result.Contains<"retries">());
+  REQUIRE(retries == 3);
+
+  auto empty = parser.Parse("");
+  REQUIRE_FALSE(empty.Get<"hour">().has_value());
+}
+
+TEST_CASE("Parsed values override defaults", "[defaults]") {
+  auto result = parser.Parse("-d 2 --retries 9");
+  REQUIRE(result.Get<"day">().value() == 2);
+  REQUIRE(retries == 9);
+
+  // Default isn't a duplicate of the parsed value
+  REQUIRE(parser.TryParse("--ratio 1.5").has_value());
+  auto duplicate = parser.TryParse("--day 1 -d 2");
+  REQUIRE_FALSE(duplicate.has_value());
+  REQUIRE(duplicate.error().code == optica::ErrorCode::DuplicateOption);
+
+  Result reused;
+  parser.ParseInto(reused, "--day 4");
+  parser.ParseInto(reused, "--hour 1");
+  REQUIRE(reused.Get<"day">().value() == 7);
+  REQUIRE(retries == 3);
+}
+
+TEST_CASE("Defaults of non trivial results are assigned", "[defaults]") {
+  const auto string_parser = optica::Parser(
+      optica::Opt<"name", std::string>() |
+          optica::DefaultValue(std::string(40, 'n')),
+      optica::Opt<"day", int>() | optica::DefaultValue(1));
+  using StringResult = decltype(string_parser)::ParseResultType;
+  STATIC_REQUIRE_FALSE(StringResult::kTriviallyCopyable);
+
+  StringResult result;
+  string_parser.ParseInto(result, "--name custom");
+  REQUIRE(result.Get<"name">().value() == "custom");
+  REQUIRE(result.Get<"day">().value() == 1);
+
+  string_parser.ParseInto(result, "--day 2");
+  REQUIRE(result.Get<"name">().value() == std::string(40, 'n'));
+  REQUIRE(result.Get<"day">().value() == 2);
+}
@@ -0,0 +1,55 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <string>
+
+enum class Mode : std::uint8_t { Local = 1, Replicated = 7, Sharded = 200 };
+
+template <>
+struct optica::EnumTraits<Mode> {
+  static constexpr std::array kNames = {
+      optica::EnumEntry{"local", Mode::Local},
+      optica::EnumEntry{"replicated", Mode::Replicated},
+      optica::EnumEntry{"sharded", Mode::Sharded}};
+};
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"mode", Mode>() | optica::ShortName<"m">() |
+        optica::DefaultValue(Mode::Local),
+    optica::Opt<"fallbacks", std::array<Mode, 2>>() |
+        optica::Arity<optica::Exact<2>>());
+
+TEST_CASE("Enumerators are parsed by name", "[enum]") {
+  auto result = parser.Parse("--mode=replicated --fallbacks sharded,local");
+  REQUIRE(result.Get<"mode">().value() == Mode::Replicated);
+  REQUIRE(result.Get<"fallbacks">().value()[0] == Mode::Sharded);
+
+  REQUIRE(parser.Parse("").Get<"mode">().value() == Mode::Local);
+
+  STATIC_REQUIRE([] {
+    Mode mode{};
+    return optica::TypeParser<Mode>::TryParseValue(
+               optica::Token{"sharded", optica::Token::TokenType::Word},
+               mode) == optica::ErrorCode::Ok &&
+           mode == Mode::Sharded;
+  }());
+}
+
+TEST_CASE("Unknown enumerator names are rejected", "[enum]") {
+  auto result = parser.TryParse("-m replica");
+  REQUIRE_FALSE(result.has_value());
+  REQUIRE(result.error().code == optica::ErrorCode::InvalidValue);
+  REQUIRE(result.error().offset == 3);
+
+  REQUIRE_FALSE(parser.TryParse("--mode Local").has_value());
+  REQUIRE_FALSE(parser.TryParse("--mode localx").has_value());
+}
+
+TEST_CASE("Enumerators are formatted by name", "[enum]") {
+  STATIC_REQUIRE(optica::EnumName(Mode::Sharded) == "sharded");
+  REQUIRE(optica::EnumName(static_cast<Mode>(3)).empty());
+
+  auto option = optica::details::make_program_option(
+      optica::Opt<"mode", Mode>() | optica::DefaultValue(Mode::Replicated));
+  REQUIRE(option.GenerateDescription().find("Default value: replicated") !=
+          std::string::npos);
+}
@@ -0,0 +1,55 @@
+#include <catch2/catch_all.hpp>
+#include <cstring>
+#include <format>
+#include <optica/optica.hpp>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"host", optica::InlineString<16>>() | optica::ShortName<"h">(),
+    optica::Opt<"tags", std::array<optica::InlineString<8>, 2>>() |
+        optica::Arity<optica::Exact<2>>(),
+    optica::Opt<"port", int>());
+
+using Result = decltype(parser)::ParseResultType;
+
+TEST_CASE("Inline string keeps value without allocation", "[inline_string]") {
+  auto result = parser.Parse("-h db.internal --tags blue,green");
+  auto host = result.Get<"host">().value();
+
+  REQUIRE(host == "db.internal");
+  REQUIRE(host.size() == 11);
+  REQUIRE(std::strlen(host.c_str()) == 11);
+  REQUIRE(result.Get<"tags">().value()[1] == "green");
+  REQUIRE(std::format("{}", host) == "db.internal");
+
+  constexpr auto value = [] {
+    optica::InlineString<4> string;
+    string.TryAssign("abcd");
+    return string;
+  }();
+  STATIC_REQUIRE(value == "abcd");
+  STATIC_REQUIRE(sizeof(value) == 6);
+}
+
+TEST_CASE("Inline string reports overflow", "[inline_string]") {
+  auto parsed = parser.TryParse("--host a-very-long-host-name.example");
+  REQUIRE_FALSE(parsed.has_value());
+  REQUIRE(parsed.error().code == optica::ErrorCode::StringTooLong);
+
+  optica::InlineString<3> string;
+  REQUIRE(string.TryAssign("abc"));
+  REQUIRE_FALSE(string.TryAssign("abcd"));
+  REQUIRE(string == "abc");
+}
+
+TEST_CASE("Result with inline strings is copied as bytes", "[inline_string]") {
+  STATIC_REQUIRE(Result::kTriviallyCopyable);
+  STATIC_REQUIRE_FALSE(Result::kBorrowsInput);
+
+  auto source = parser.Parse("--host cache --port 6379");
+  Result copy;
+  std::memcpy(static_cast<void*>(&copy), &source, sizeof(Result));
+
+  REQUIRE(copy.Get<"host">().value() == "cache");
+  REQUIRE(copy.Get<"port">().value() == 6379);
+  REQUIRE_FALSE(copy.Contains<"tags">());
+}
@@ -0,0 +1,45 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+
+namespace {
+template <std::size_t I>
+constexpr auto MakeName() {
+  return optica::FixedString<4>(std::array<char, 4>{
+      'o', static_cast<char>('0' + I / 100 % 10),
+      static_cast<char>('0' + I / 10 % 10), static_cast<char>('0' + I % 10)});
+}
+
+template <std::size_t... Is>
+constexpr auto MakeParser(std::index_sequence<Is...>) {
+  return optica::Parser(optica::Opt<MakeName<Is>(), int>()...);
+}
+}  // namespace
+
+constexpr auto parser = MakeParser(std::make_index_sequence<180>{});
+
+TEST_CASE("Long names are dispatched by perfect hash", "[parser]") {
+  auto result = parser.Parse("--o179 1 --o000 2 --o090 3");
+
+  REQUIRE(result.Get<"o179">().value() == 1);
+  REQUIRE(result.Get<"o000">().value() == 2);
+  REQUIRE(result.Get<"o090">().value() == 3);
+  REQUIRE_FALSE(result.Get<"o001">().has_value());
+}
+
+TEST_CASE("Unknown long names are rejected", "[parser]") {
+  REQUIRE_THROWS_AS(parser.Parse("--o180 1"), std::invalid_argument);
+  REQUIRE_THROWS_AS(parser.Parse("--o17 1"), std::invalid_argument);
+}
+
+TEST_CASE("Perfect hash finds every key", "[parser]") {
+  constexpr std::array<std::string_view, 5> keys = {"day", "week", "month",
+                                                    "year", "d"};
+  using optica::details::HashString;
+  constexpr optica::details::PerfectHash<5> hash{std::array{
+      HashString(keys[0]), HashString(keys[1]), HashString(keys[2]),
+      HashString(keys[3]), HashString(keys[4])}};
+
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    REQUIRE(hash.Find(HashString(keys[i])) == i);
+  }
+}
@@ -0,0 +1,79 @@
+#include <array>
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <string>
+#include <string_view>
+
+namespace {
+struct Range {
+  int low{};
+  int high{};
+};
+
+struct Route {
+  std::string region;
+  Range ports;
+  std::array<std::string_view, 3> hosts;
+};
+}  // namespace
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"route", Route>(),
+    optica::Opt<"grid", std::array<std::array<int, 2>, 2>>());
+
+TEST_CASE("Compound tree follows nested brackets", "[compound]") {
+  constexpr std::string_view data = "eu, {10, 20},{a,b, {c}}, ";
+  optica::CompoundTree<16> tree;
+  REQUIRE(tree.Build(data) == optica::ErrorCode::Ok);
+
+  auto root = tree.GetRoot();
+  REQUIRE(root.GetSize() == 3);
+  auto region = root.GetFirstChild();
+  REQUIRE(region.GetToken().GetTokenData() == "eu");
+  auto ports = region.GetNext();
+  REQUIRE(ports.IsCompound());
+  REQUIRE(ports.GetToken().GetTokenData() == "10, 20");
+  REQUIRE(ports.GetFirstChild().GetNext().GetToken().GetTokenData() == "20");
+  auto hosts = ports.GetNext();
+  REQUIRE(hosts.GetSize() == 3);
+  REQUIRE_FALSE(hosts.HasNext());
+  REQUIRE(hosts.GetFirstChild().GetNext().GetNext().GetToken() ==
+          optica::Token("c", optica::Token::TokenType::CompoundName));
+
+  for (std::string_view invalid : {"{1", "1}", "a{1}", "{1} b", "{1}{2}"}) {
+    REQUIRE(tree.Build(invalid) == optica::ErrorCode::InvalidValue);
+  }
+  REQUIRE(optica::CompoundTree<3>{}.Build("1,2,3") ==
+          optica::ErrorCode::TooManyUnits);
+}
+
+TEST_CASE("Nested values are decoded from tree", "[compound]") {
+  auto result = parser.Parse(
+      "--route {eu, {10, 20}, {a, b, c}} --grid={{1,2},{3,4}}");
+  auto route = result.Get<"route">().value();
+  auto grid = result.Get<"grid">().value();
+
+  REQUIRE(route.region == "eu");
+  REQUIRE(route.ports.low == 10);
+  REQUIRE(route.ports.high == 20);
+  REQUIRE(route.hosts[2] == "c");
+  REQUIRE(grid[0][1] == 2);
+  REQUIRE(grid[1][0] == 3);
+
+  auto token = optica::Token("1, {2, 3}, 4", optica::Token::TokenType::Word);
+  REQUIRE(token.GetTokenSize() == 3);
+  REQUIRE(token.ExtractTokenUnits<3>()[1].GetTokenData() == "2, 3");
+}
+
+TEST_CASE("Nested values report mismatched shape", "[compound]") {
+  using enum optica::ErrorCode;
+  for (auto [input, code] :
+       {std::pair{"--route {eu, 10, {a, b, c}}", NotEnoughValues},
+        std::pair{"--route {eu, {1, 2, 3}, {a, b, c}}", TooManyUnits},
+        std::pair{"--route {eu, {1, x}, {a, b, c}}", InvalidValue},
+        std::pair{"--grid {{1, 2}, {3, 4}, {5, 6}}", TooManyUnits}}) {
+    auto parsed = parser.TryParse(input);
+    REQUIRE_FALSE(parsed.has_value());
+    REQUIRE(parsed.error().code == code);
+  }
+}
@@ -0,0 +1,100 @@
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstdint>
+#include <optica/optica.hpp>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"count", std::int8_t>(),
+    optica::Opt<"size", std::uint64_t>() | optica::ShortName<"s">(),
+    optica::Opt<"offset", long>(),
+    optica::Opt<"ratio", float>(),
+    optica::Opt<"timeout", std::chrono::milliseconds>(),
+    optica::Opt<"delay", std::chrono::duration<double>>());
+
+namespace {
+template <typename T>
+optica::ErrorCode Parse(std::string_view data, T& value) {
+  return optica::TypeParser<T>::TryParseValue(
+      optica::Token{data, optica::Token::TokenType::Word}, value);
+}
+}  // namespace
+
+TEST_CASE("Integers are range checked", "[numeric]") {
+  using optica::ErrorCode;
+  std::int8_t small{};
+  REQUIRE(Parse("-128", small) == ErrorCode::Ok);
+  REQUIRE(small == -128);
+  REQUIRE(Parse("128", small) == ErrorCode::OutOfRange);
+  REQUIRE(Parse("12x", small) == ErrorCode::InvalidValue);
+  REQUIRE(Parse("", small) == ErrorCode::InvalidValue);
+  REQUIRE(small == -128);
+
+  std::uint64_t big{};
+  REQUIRE(Parse("18446744073709551615", big) == ErrorCode::Ok);
+  REQUIRE(Parse("18446744073709551616", big) == ErrorCode::OutOfRange);
+  REQUIRE(Parse("-1", big) == ErrorCode::OutOfRange);
+  REQUIRE(Parse("0xFF", big) == ErrorCode::Ok);
+  REQUIRE(big == 255);
+  REQUIRE(Parse("0b1010", big) == ErrorCode::Ok);
+  REQUIRE(big == 10);
+  REQUIRE(Parse("1'000_000", big) == ErrorCode::Ok);
+  REQUIRE(big == 1'000'000);
+  REQUIRE(Parse("1__0", big) == ErrorCode::InvalidValue);
+  REQUIRE(Parse("4Ki", big) == ErrorCode::Ok);
+  REQUIRE(big == 4096);
+  REQUIRE(Parse("2G", big) == ErrorCode::Ok);
+  REQUIRE(big == 2'000'000'000);
+  REQUIRE(Parse("20000Pi", big) == ErrorCode::OutOfRange);
+  REQUIRE(Parse("2X", big) == ErrorCode::InvalidValue);
+
+  STATIC_REQUIRE([] {
+    int value{};
+    return optica::details::ParseInteger("-0x7FFF'FFFF", value) ==
+               optica::ErrorCode::Ok &&
+           value == -0x7FFFFFFF;
+  }());
+}
+
+TEST_CASE("Floating numbers and durations have suffixes", "[numeric]") {
+  using optica::ErrorCode;
+  double value{};
+  REQUIRE(Parse("-2.5e-3", value) == ErrorCode::Ok);
+  REQUIRE(value == -2.5e-3);
+  REQUIRE(Parse("1'000.5", value) == ErrorCode::Ok);
+  REQUIRE(value == 1000.5);
+  REQUIRE(Parse("1.5K", value) == ErrorCode::Ok);
+  REQUIRE(value == 1500.0);
+  REQUIRE(Parse("1e999", value) == ErrorCode::OutOfRange);
+  REQUIRE(Parse("abc", value) == ErrorCode::InvalidValue);
+
+  std::chrono::milliseconds timeout{};
+  REQUIRE(Parse("250ms", timeout) == ErrorCode::Ok);
+  REQUIRE(timeout.count() == 250);
+  REQUIRE(Parse("2min", timeout) == ErrorCode::Ok);
+  REQUIRE(timeout.count() == 120'000);
+  REQUIRE(Parse("40", timeout) == ErrorCode::Ok);
+  REQUIRE(timeout.count() == 40);
+  REQUIRE(Parse("1500us", timeout) == ErrorCode::InvalidValue);
+  REQUIRE(Parse("3 weeks", timeout) == ErrorCode::InvalidValue);
+
+  std::chrono::duration<double> seconds{};
+  REQUIRE(Parse("250ms", seconds) == ErrorCode::Ok);
+  REQUIRE(seconds.count() == 0.25);
+}
+
+TEST_CASE("Parser reports numeric errors", "[numeric]") {
+  auto result = parser.Parse(
+      "--count -5 -s 4Mi --offset -0x10 --ratio 0.5 --timeout 2s "
+      "--delay 1.5h");
+  REQUIRE(result.Get<"count">().value() == -5);
+  REQUIRE(result.Get<"size">().value() == 4 * 1024 * 1024);
+  REQUIRE(result.Get<"offset">().value() == -16);
+  REQUIRE(result.Get<"ratio">().value() == 0.5f);
+  REQUIRE(result.Get<"timeout">().value() == std::chrono::seconds(2));
+  REQUIRE(result.Get<"delay">().value().count() == 5400.0);
+
+  auto overflow = parser.TryParse("--count 300");
+  REQUIRE_FALSE(overflow.has_value());
+  REQUIRE(overflow.error().code == optica::ErrorCode::OutOfRange);
+  REQUIRE(overflow.error().offset == 8);
+}
@@ -0,0 +1,85 @@
+#include <array>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <optica/optica.hpp>
+#include <string_view>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"all", bool>() | optica::ShortName<"a">(),
+    optica::Opt<"day", int>() | optica::ShortName<"d">(),
+    optica::Opt<"brief", bool>() | optica::ShortName<"b">(),
+    optica::Opt<"ratio", double>(),
+    optica::Opt<"color", bool>() | optica::ShortName<"c">(),
+    optica::Opt<"hour", int>());
+
+using Result = decltype(parser)::ParseResultType;
+
+TEST_CASE("Packed result is smaller than tuple of optionals", "[result]") {
+  // double, int, int, three bools and two bytes of presence mask
+  STATIC_REQUIRE(Result::kPackedSize == 24);
+  STATIC_REQUIRE(sizeof(Result) == Result::kPackedSize);
+  STATIC_REQUIRE(Result::kUnpackedSize == 48);
+}
+
+TEST_CASE("Single byte options share byte of presence mask", "[result]") {
+  constexpr auto flag = optica::Parser(optica::Opt<"verbose", bool>());
+  using FlagResult = decltype(flag)::ParseResultType;
+  STATIC_REQUIRE(FlagResult::kPackedSize == 2);
+  STATIC_REQUIRE(FlagResult::kPackedSize <= FlagResult::kUnpackedSize);
+  REQUIRE(flag.Parse("--verbose").Get<"verbose">().value());
+  REQUIRE_FALSE(flag.TryParse("--verbose --verbose").has_value());
+
+  constexpr auto level = optica::Parser(optica::Opt<"level", std::int8_t>());
+  using LevelResult = decltype(level)::ParseResultType;
+  STATIC_REQUIRE(LevelResult::kPackedSize == LevelResult::kUnpackedSize);
+  REQUIRE(level.Parse("--level -3").Get<"level">() == -3);
+}
+
+TEST_CASE("Packed result fits representative layouts", "[result]") {
+  using Wide = decltype(optica::Parser(
+      optica::Opt<"name", std::string_view>(),
+      optica::Opt<"size", std::uint64_t>(), optica::Opt<"mode", char>(),
+      optica::Opt<"tags", std::array<std::int16_t, 3>>() |
+          optica::Arity<optica::Exact<3>>()))::ParseResultType;
+  STATIC_REQUIRE(Wide::kPackedSize <= Wide::kUnpackedSize);
+
+  using Flags = decltype(optica::Parser(
+      optica::Flag<"a">(), optica::Flag<"b">(), optica::Flag<"c">(),
+      optica::Flag<"d">(), optica::Flag<"e">()))::ParseResultType;
+  STATIC_REQUIRE(Flags::kPackedSize <= Flags::kUnpackedSize);
+
+  using Numbers = decltype(optica::Parser(
+      optica::Opt<"x", double>(), optica::Opt<"y", float>(),
+      optica::Opt<"z", std::int8_t>()))::ParseResultType;
+  STATIC_REQUIRE(Numbers::kPackedSize <= Numbers::kUnpackedSize);
+}
+
+TEST_CASE("Packed result keeps values of options", "[result]") {
+  auto result = parser.Parse("-ac --day 3 --ratio 0.5 --hour 7");
+
+  REQUIRE(result.Get<"all">().value());
+  REQUIRE_FALSE(result.Get<"brief">().has_value());
+  REQUIRE(result.Get<"color">().value());
+  REQUIRE(result.Get<"day">().value() == 3);
+  REQUIRE(result.Get<"ratio">().value() == 0.5);
+  REQUIRE(result.Get<"hour">().value() == 7);
+}
+
+TEST_CASE("Bit mask stores bits in smallest words", "[result]") {
+  STATIC_REQUIRE(sizeof(optica::details::BitMask<8>) == 1);
+  STATIC_REQUIRE(sizeof(optica::details::BitMask<9>) == 2);
+  STATIC_REQUIRE(sizeof(optica::details::BitMask<130>) == 24);
+
+  optica::details::BitMask<130> mask;
+  REQUIRE(mask.None());
+  mask.Set(0);
+  mask.Set(64);
+  mask.Set(129);
+  REQUIRE(mask.Test(64));
+  REQUIRE_FALSE(mask.Test(65));
+  REQUIRE(mask.Count() == 3);
+  mask.Reset(64);
+  REQUIRE_FALSE(mask.Test(64));
+  mask.Clear();
+  REQUIRE(mask.None());
+}
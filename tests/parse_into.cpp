@@ -0,0 +1,79 @@
+#include <catch2/catch_all.hpp>
+#include <memory_resource>
+#include <optica/optica.hpp>
+#include <string>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"name", std::string>() | optica::ShortName<"n">(),
+    optica::Opt<"day", int>() | optica::ShortName<"d">(),
+    optica::Opt<"tags", std::array<std::string, 2>>() |
+        optica::Arity<optica::Exact<2>>());
+
+using Result = decltype(parser)::ParseResultType;
+
+TEST_CASE("Parse into result reuses string memory", "[parse_into]") {
+  struct CountingResource : std::pmr::memory_resource {
+    std::size_t allocations{};
+
+    void* do_allocate(std::size_t size, std::size_t alignment) override {
+      ++allocations;
+      return std::pmr::new_delete_resource()->allocate(size, alignment);
+    }
+    void do_deallocate(void* pointer, std::size_t size,
+                       std::size_t alignment) override {
+      std::pmr::new_delete_resource()->deallocate(pointer, size, alignment);
+    }
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+      return this == &other;
+    }
+  } resource;
+
+  constexpr auto pmr_parser = optica::Parser(
+      optica::Opt<"name", std::pmr::string>() | optica::ShortName<"n">());
+  decltype(pmr_parser)::ParseResultType result{&resource};
+  const std::string first = "--name " + std::string(64, 'x');
+  const std::string second = "-n " + std::string(32, 'y');
+  const std::string third = "--name " + std::string(48, 'z');
+  optica::TokenTape tape{first};
+  pmr_parser.ParseInto(result, tape);
+  const std::size_t warm = resource.allocations;
+  REQUIRE(warm > 0);
+
+  tape.Build(second);
+  REQUIRE(pmr_parser.TryParseInto(result, tape).has_value());
+  tape.Build(third);
+  pmr_parser.ParseInto(result, tape);
+
+  REQUIRE(resource.allocations == warm);
+  REQUIRE(result.Get<"name">().value().size() == 48);
+}
+
+TEST_CASE("Reset clears presence of all options", "[parse_into]") {
+  Result result;
+  parser.ParseInto(result, "--name first -d 3");
+  REQUIRE(result.Get<"day">().value() == 3);
+
+  result.Reset();
+  REQUIRE_FALSE(result.Get<"name">().has_value());
+  REQUIRE_FALSE(result.Get<"day">().has_value());
+
+  const char* argv[] = {"prog", "-d", "4"};
+  parser.ParseInto(result, 3, argv);
+  REQUIRE(result.Get<"day">().value() == 4);
+  REQUIRE_FALSE(result.Get<"name">().has_value());
+}
+
+TEST_CASE("Parse into result reports errors", "[parse_into]") {
+  Result result;
+  parser.ParseInto(result, "--name first");
+
+  auto parsed = parser.TryParseInto(result, "--day x");
+  REQUIRE_FALSE(parsed.has_value());
+  REQUIRE(parsed.error().code == optica::ErrorCode::InvalidValue);
+  REQUIRE_THROWS_AS(parser.ParseInto(result, "--unknown"),
+                    std::invalid_argument);
+
+  parser.ParseInto(result, "--day 5");
+  REQUIRE(result.Get<"day">().value() == 5);
+  REQUIRE_FALSE(result.Get<"name">().has_value());
+}
@@ -0,0 +1,87 @@
+#include <array>
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <optica/optica.hpp>
+
+namespace {
+std::atomic<std::size_t> allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++allocations;
+  if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"name", std::pmr::string>() | optica::ShortName<"n">(),
+    optica::Opt<"day", int>() | optica::ShortName<"d">(),
+    optica::Opt<"tags", std::array<std::pmr::string, 3>>() |
+        optica::Arity<optica::Exact<3>>());
+
+TEST_CASE("Parse with reset arena makes no global allocations", "[pmr]") {
+  const std::string long_value(100, 'x');
+  const std::string_view expected_name = long_value;
+  const std::string command = "--name " + long_value +
+                              " -d 3 --tags first_long_tag_value,"
+                              "second_long_tag_value,third_long_tag_value";
+  optica::TokenTape tape{command};
+  alignas(std::max_align_t) std::array<std::byte, 4096> buffer;
+  std::pmr::monotonic_buffer_resource arena{
+      buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+  for (int i = 0; i < 3; ++i) {
+    const std::size_t before = allocations;
+    auto result = parser.TryParse(tape, &arena);
+    const std::size_t after = allocations;
+
+    REQUIRE(after == before);
+    REQUIRE(result.has_value());
+    REQUIRE(result->Get<"name">().value() == expected_name);
+    REQUIRE(result->Get<"day">().value() == 3);
+    REQUIRE(result->Get<"tags">().value()[2] == "third_long_tag_value");
+    arena.release();
+  }
+}
+
+TEST_CASE("String values are allocated from resource", "[pmr]") {
+  struct CountingResource : std::pmr::memory_resource {
+    std::size_t bytes{};
+
+    void* do_allocate(std::size_t size, std::size_t alignment) override {
+      bytes += size;
+      return std::pmr::new_delete_resource()->allocate(size, alignment);
+    }
+    void do_deallocate(void* pointer, std::size_t size,
+                       std::size_t alignment) override {
+      std::pmr::new_delete_resource()->deallocate(pointer, size, alignment);
+    }
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+      return this == &other;
+    }
+  } resource;
+
+  auto result = parser.Parse("--name " + std::string(64, 'y'), &resource);
+
+  REQUIRE(result.Get<"name">().value().size() == 64);
+  REQUIRE(resource.bytes > 64);
+}
+
+TEST_CASE("Parse without resource uses default resource", "[pmr]") {
+  auto result = parser.Parse("--tags a,b,c");
+  auto tags = result.Get<"tags">().value();
+
+  REQUIRE(tags[0] == "a");
+  REQUIRE(tags[2] == "c");
+  REQUIRE_FALSE(result.Get<"name">().has_value());
+}
@@ -0,0 +1,52 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"all", bool>() | optica::ShortName<"a">(),
+    optica::Opt<"brief", bool>() | optica::ShortName<"b">(),
+    optica::Opt<"color", bool>() | optica::ShortName<"c">(),
+    optica::Opt<"day", int>() | optica::ShortName<"d">(),
+    optica::Opt<"week", std::array<int, 3>>() | optica::ShortName<"w">() |
+        optica::Arity<optica::Exact<3>>());
+
+TEST_CASE("Cluster of short flags is parsed in one token", "[short]") {
+  using enum optica::Token::TokenType;
+  optica::TokenTape tape{"-abc --day 1"};
+  REQUIRE(tape.size() == 3);
+  REQUIRE(tape[0] == optica::Token("abc", ShortName));
+
+  auto result = parser.Parse(tape);
+  REQUIRE(result.Get<"all">().value());
+  REQUIRE(result.Get<"brief">().value());
+  REQUIRE(result.Get<"color">().value());
+  REQUIRE(result.Get<"day">().value() == 1);
+
+  result = parser.Parse("-b --all");
+  REQUIRE(result.Get<"all">().value());
+  REQUIRE(result.Get<"brief">().value());
+  REQUIRE_FALSE(result.Get<"color">().has_value());
+}
+
+TEST_CASE("Cluster ends with option taking values", "[short]") {
+  auto result = parser.Parse("-acd42");
+  REQUIRE(result.Get<"all">().value());
+  REQUIRE(result.Get<"color">().value());
+  REQUIRE(result.Get<"day">().value() == 42);
+
+  result = parser.Parse("-bd 7 -w1,2,3");
+  REQUIRE(result.Get<"brief">().value());
+  REQUIRE(result.Get<"day">().value() == 7);
+  REQUIRE(result.Get<"week">().value() == std::array{1, 2, 3});
+
+  const char* argv[] = {"prog", "-cw", "4", "5", "6"};
+  result = parser.Parse(5, argv);
+  REQUIRE(result.Get<"color">().value());
+  REQUIRE(result.Get<"week">().value() == std::array{4, 5, 6});
+}
+
+TEST_CASE("Bad clusters are rejected", "[short]") {
+  REQUIRE_THROWS_AS(parser.Parse("-abx"), std::invalid_argument);
+  REQUIRE_THROWS_AS(parser.Parse("-aa"), std::invalid_argument);
+  REQUIRE_THROWS_AS(parser.Parse("- 1"), std::invalid_argument);
+  REQUIRE_THROWS_AS(parser.Parse("-w1,2"), std::invalid_argument);
+}
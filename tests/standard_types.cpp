@@ -0,0 +1,84 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <variant>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"limit", std::pair<std::string, int>>(),
+    optica::Opt<"shard", std::tuple<std::string_view, int, double>>(),
+    optica::Opt<"retries", std::variant<std::string, int>>(),
+    optica::Opt<"window", std::tuple<std::optional<int>, int>>(),
+    optica::Opt<"grid", std::variant<int, std::array<int, 2>>>());
+
+TEST_CASE("Pairs and tuples are decoded from compound token", "[types]") {
+  auto result = parser.Parse(
+      "--limit {cpu, 4} --shard={eu-1, 3, 0.5} --window {, 10}");
+  auto [resource, amount] = result.Get<"limit">().value();
+  auto [name, index, weight] = result.Get<"shard">().value();
+  auto window = result.Get<"window">().value();
+
+  REQUIRE(resource == "cpu");
+  REQUIRE(amount == 4);
+  REQUIRE(name == "eu-1");
+  REQUIRE(index == 3);
+  REQUIRE(weight == 0.5);
+  REQUIRE_FALSE(std::get<0>(window).has_value());
+  REQUIRE(std::get<1>(window) == 10);
+
+  constexpr auto pair = [] {
+    std::pair<int, std::tuple<int, int>> value;
+    optica::TypeParser<decltype(value)>::TryParseValue(
+        optica::Token{"1, {2, 3}", optica::Token::TokenType::CompoundName},
+        value);
+    return value;
+  }();
+  STATIC_REQUIRE(pair.first == 1);
+  STATIC_REQUIRE(std::get<1>(pair.second) == 3);
+}
+
+TEST_CASE("Variant tries cheap alternatives first", "[types]") {
+  auto number = parser.Parse("--retries 5 --grid 7");
+  REQUIRE(std::get<int>(number.Get<"retries">().value()) == 5);
+  REQUIRE(std::get<int>(number.Get<"grid">().value()) == 7);
+
+  auto word = parser.Parse("--retries forever --grid {1, 2}");
+  REQUIRE(std::get<std::string>(word.Get<"retries">().value()) ==
+          "forever");
+  REQUIRE(std::get<1>(word.Get<"grid">().value())[1] == 2);
+
+  STATIC_REQUIRE(optica::details::GetDecodeCost<int>() <
+                 optica::details::GetDecodeCost<std::string>());
+}
+
+TEST_CASE("Standard types report invalid units", "[types]") {
+  using enum optica::ErrorCode;
+  for (auto [input, code] :
+       {std::pair{"--limit {cpu}", NotEnoughValues},
+        std::pair{"--limit {cpu, 4, 5}", TooManyUnits},
+        std::pair{"--shard {eu, x, 0.5}", InvalidValue},
+        std::pair{"--grid {1, x}", InvalidValue}}) {
+    auto parsed = parser.TryParse(input);
+    REQUIRE_FALSE(parsed.has_value());
+    REQUIRE(parsed.error().code == code);
+  }
+}
+
+TEST_CASE("Standard types holding views borrow input", "[types]") {
+  using optica::details::is_borrowed_value;
+  STATIC_REQUIRE(is_borrowed_value<std::optional<std::string_view>>::value);
+  STATIC_REQUIRE(is_borrowed_value<std::pair<int, std::string_view>>::value);
+  STATIC_REQUIRE(
+      is_borrowed_value<std::tuple<int, std::optional<std::string_view>>>::
+          value);
+  STATIC_REQUIRE(
+      is_borrowed_value<std::variant<int, std::string_view>>::value);
+  STATIC_REQUIRE_FALSE(
+      is_borrowed_value<std::variant<int, std::string>>::value);
+
+  // Shard holds std::string_view, so result refuses temporary input
+  STATIC_REQUIRE(decltype(parser)::ParseResultType::kBorrowsInput);
+}
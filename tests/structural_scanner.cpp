@@ -0,0 +1,81 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+std::string RandomCommand(std::mt19937& generator, std::size_t length) {
+  constexpr std::string_view alphabet = "  ,,=={}--abcxyz0123456789";
+  std::uniform_int_distribution<std::size_t> pick(0, alphabet.size() - 1);
+  std::string result(length, ' ');
+  for (auto& symbol : result) {
+    symbol = alphabet[pick(generator)];
+  }
+  return result;
+}
+
+template <typename Scanner>
+std::vector<optica::Token> Tokenize(std::string_view data) {
+  std::vector<optica::Token> result;
+  const char* current = data.data();
+  const char* end = data.data() + data.size();
+  while (true) {
+    auto token = optica::details::ScanToken<Scanner>(current, end);
+    if (token.GetTokenType() == optica::Token::TokenType::None) {
+      break;
+    }
+    result.push_back(token);
+  }
+  return result;
+}
+}  // namespace
+
+TEST_CASE("Structural scanner matches scalar scanner", "[tokenizer]") {
+  using Scalar = optica::details::ScalarScanner;
+  using Simd = optica::details::DefaultScanner;
+  constexpr auto kArgument = optica::details::SeparatorSet::kArgument;
+  std::mt19937 generator(42);
+
+  for (std::size_t length = 0; length < 200; ++length) {
+    auto data = RandomCommand(generator, length);
+    const char* begin = data.data();
+    const char* end = data.data() + data.size();
+    for (const char* it = begin; it != end; ++it) {
+      REQUIRE(Scalar::SkipSeparators(it, end) == Simd::SkipSeparators(it, end));
+      REQUIRE(Scalar::FindSeparator(it, end) == Simd::FindSeparator(it, end));
+      REQUIRE(Scalar::Find(it, end, '}') == Simd::Find(it, end, '}'));
+      REQUIRE(Scalar::Count(it, end, ',') == Simd::Count(it, end, ','));
+      REQUIRE(Scalar::FindBracket(it, end) == Simd::FindBracket(it, end));
+      REQUIRE(Scalar::FindStructural(it, end) ==
+              Simd::FindStructural(it, end));
+      REQUIRE(Scalar::SkipSeparators<kArgument>(it, end) ==
+              Simd::SkipSeparators<kArgument>(it, end));
+      REQUIRE(Scalar::FindSeparator<kArgument>(it, end) ==
+              Simd::FindSeparator<kArgument>(it, end));
+    }
+  }
+}
+
+TEST_CASE("Structural tokenizer matches scalar tokenizer", "[tokenizer]") {
+  using Scalar = optica::details::ScalarScanner;
+  using Simd = optica::details::DefaultScanner;
+  std::mt19937 generator(7);
+
+  for (std::size_t i = 0; i < 2000; ++i) {
+    auto data = RandomCommand(generator, i % 300);
+    REQUIRE(Tokenize<Scalar>(data) == Tokenize<Simd>(data));
+  }
+}
+
+TEST_CASE("Structural tokenizer handles long tokens", "[tokenizer]") {
+  std::string data = "--" + std::string(100, 'n') + "=" +
+                     std::string(70, ' ') + "{" + std::string(90, 'v') + "}";
+  auto tokens = Tokenize<optica::details::DefaultScanner>(data);
+
+  REQUIRE(tokens.size() == 2);
+  REQUIRE(tokens[0].GetTokenType() == optica::Token::TokenType::LongName);
+  REQUIRE(tokens[0].GetTokenData() == std::string(100, 'n'));
+  REQUIRE(tokens[1].GetTokenType() == optica::Token::TokenType::CompoundName);
+  REQUIRE(tokens[1].GetTokenData() == std::string(90, 'v'));
+}
@@ -0,0 +1,48 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+
+constexpr auto parser =
+    optica::Parser(optica::Opt<"day", int>() | optica::ShortName<"d">(),
+                   optica::Opt<"week", std::array<int, 3>>() |
+                       optica::Arity<optica::Exact<3>>());
+
+TEST_CASE("Token tape holds all tokens of the input", "[tape]") {
+  using enum optica::Token::TokenType;
+  optica::TokenTape tape{"--day=3 -d {1, 2} word"};
+
+  REQUIRE(tape.size() == 5);
+  REQUIRE(tape[0] == optica::Token("day", LongName));
+  REQUIRE(tape[1] == optica::Token("3", Word));
+  REQUIRE(tape[2] == optica::Token("d", ShortName));
+  REQUIRE(tape[3] == optica::Token("1, 2", CompoundName));
+  REQUIRE(tape[4] == optica::Token("word", Word));
+  REQUIRE(tape[5] == optica::Token{});
+  REQUIRE(tape.GetTokenType(4) == Word);
+}
+
+TEST_CASE("Token tape iterator is random access", "[tape]") {
+  optica::TokenTape tape{"--week 1,2,3 --day 4"};
+  auto begin = tape.begin();
+
+  REQUIRE(tape.end() - begin == 6);
+  REQUIRE((*(begin + 4)).GetTokenData() == "day");
+  REQUIRE(begin[5].GetTokenData() == "4");
+  REQUIRE((tape.end() - 3)[0].GetTokenData() == "3");
+  REQUIRE(begin + 6 == tape.end());
+}
+
+TEST_CASE("Token tape can be reused across parses", "[tape]") {
+  optica::TokenTape tape;
+  tape.Build("--week 1,2,3 --day 4");
+  auto first = parser.Parse(tape);
+  auto capacity = tape.Capacity();
+
+  tape.Build("-d 8");
+  auto second = parser.Parse(tape);
+
+  REQUIRE(tape.Capacity() == capacity);
+  REQUIRE(first.Get<"day">().value() == 4);
+  REQUIRE(first.Get<"week">().value() == std::array{1, 2, 3});
+  REQUIRE(second.Get<"day">().value() == 8);
+  REQUIRE_FALSE(second.Get<"week">().has_value());
+}
@@ -0,0 +1,31 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <string>
+
+TEST_CASE("Token size is computed on demand", "[token]") {
+  using enum optica::Token::TokenType;
+  std::string hosts = "h0";
+  for (int i = 1; i < 1000; ++i) {
+    hosts += ",h" + std::to_string(i);
+  }
+
+  REQUIRE(optica::Token("day", LongName).GetTokenSize() == 1);
+  REQUIRE(optica::Token(hosts, CompoundName).GetTokenSize() == 1000);
+}
+
+TEST_CASE("Token units are extracted in one pass", "[token]") {
+  optica::Token token(" 42 , Dmitrii,Tupitsyn ",
+                      optica::Token::TokenType::CompoundName);
+  auto units = token.ExtractTokenUnits<4>();
+
+  REQUIRE(units[0].GetTokenData() == "42");
+  REQUIRE(units[1].GetTokenData() == "Dmitrii");
+  REQUIRE(units[2].GetTokenData() == "Tupitsyn");
+  REQUIRE(units[3] == optica::Token{});
+}
+
+TEST_CASE("Token units extraction rejects extra units", "[token]") {
+  optica::Token token("1,2,3", optica::Token::TokenType::CompoundName);
+
+  REQUIRE_THROWS_AS(token.ExtractTokenUnits<2>(), std::invalid_argument);
+}
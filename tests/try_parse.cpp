@@ -0,0 +1,88 @@
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <string_view>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"all", bool>() | optica::ShortName<"a">(),
+    optica::Opt<"day", int>() | optica::ShortName<"d">(),
+    optica::Opt<"week", std::array<int, 3>>() |
+        optica::Arity<optica::Exact<3>>());
+
+TEST_CASE("TryParse returns values of well formed input", "[error]") {
+  auto result = parser.TryParse("-a --day 3 --week 1,2,3");
+  REQUIRE(result.has_value());
+  REQUIRE(result->Get<"all">().value());
+  REQUIRE(result->Get<"day">().value() == 3);
+  REQUIRE(result->Get<"week">().value() == std::array{1, 2, 3});
+
+  const char* argv[] = {"prog", "-d", "5"};
+  auto argv_result = parser.TryParse(3, argv);
+  REQUIRE(argv_result.has_value());
+  REQUIRE(argv_result->Get<"day">().value() == 5);
+}
+
+TEST_CASE("TryParse reports error code, option and offset", "[error]") {
+  using optica::ErrorCode;
+  using optica::ParseError;
+  auto expect = [](std::string_view cmd, ParseError error) {
+    auto result = parser.TryParse(cmd);
+    REQUIRE_FALSE(result.has_value());
+    REQUIRE(result.error() == error);
+  };
+
+  expect("--day 1 --month 2", {ErrorCode::UnknownArgument,
+                               ParseError::kNoOption, 10});
+  expect("-ax", {ErrorCode::UnknownArgument, ParseError::kNoOption, 2});
+  expect("word", {ErrorCode::UnsupportedToken, ParseError::kNoOption, 0});
+  expect("--day 1 -d 2", {ErrorCode::DuplicateOption, 1, 9});
+  expect("--day x1", {ErrorCode::InvalidValue, 1, 6});
+  expect("--week 1,2", {ErrorCode::NotEnoughValues, 2, 2});
+  expect("--all -d", {ErrorCode::NotEnoughValues, 1, 7});
+
+  const char* argv[] = {"prog", "--day", "1", "-z"};
+  auto result = parser.TryParse(4, argv);
+  REQUIRE_FALSE(result.has_value());
+  REQUIRE(result.error() ==
+          ParseError{ErrorCode::UnknownArgument, ParseError::kNoOption, 9});
+}
+
+TEST_CASE("Errors are formatted on request", "[error]") {
+  auto result = parser.TryParse("--day 1 --day 2");
+  REQUIRE_FALSE(result.has_value());
+  REQUIRE(parser.FormatError(result.error()) ==
+          "ERROR: Option is set more than 1 time (option --day) at offset 10");
+  REQUIRE_THROWS_AS(parser.Parse("--day 1 --day 2"), std::invalid_argument);
+
+  optica::Token token{"1, 2, 3", optica::Token::TokenType::CompoundName};
+  REQUIRE(token.TryExtractTokenUnits<2>().error() ==
+          optica::ErrorCode::TooManyUnits);
+  REQUIRE(token.TryExtractTokenUnits<3>().has_value());
+}
+
+TEST_CASE("Every token of untrusted input is checked", "[error]") {
+  using optica::ErrorCode;
+  using optica::ParseError;
+  constexpr auto kParser = optica::Parser(
+      optica::Opt<"count", int>(), optica::Opt<"name", std::string_view>(),
+      optica::Flag<"v">());
+  auto expect = [&](std::string_view cmd, ParseError error) {
+    auto result = kParser.TryParse(cmd);
+    REQUIRE_FALSE(result.has_value());
+    REQUIRE(result.error() == error);
+  };
+
+  // Trailing tokens after all options were met
+  expect("--count 5 --name z --v --bogus",
+         {ErrorCode::UnknownArgument, ParseError::kNoOption, 25});
+  expect("--count 5 --name z --v 6",
+         {ErrorCode::UnsupportedToken, ParseError::kNoOption, 23});
+
+  // Name is never swallowed as a value of the previous option
+  expect("--name -x", {ErrorCode::NotEnoughValues, 1, 2});
+  expect("--name --count 1", {ErrorCode::NotEnoughValues, 1, 2});
+
+  const char* argv[] = {"prog", "--name", "-x"};
+  auto result = kParser.TryParse(3, argv);
+  REQUIRE_FALSE(result.has_value());
+  REQUIRE(result.error().code == ErrorCode::NotEnoughValues);
+}
@@ -0,0 +1,67 @@
+#include <array>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <optica/optica.hpp>
+#include <string_view>
+
+enum class Replication { Local, Replicated };
+
+template <>
+struct optica::EnumTraits<Replication> {
+  static constexpr std::array kNames = {
+      optica::EnumEntry{"local", Replication::Local},
+      optica::EnumEntry{"replicated", Replication::Replicated}};
+};
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"threads", int>() | optica::ShortName<"t">() |
+        optica::Description<"Number of worker threads">(),
+    optica::Opt<"mode", Replication>() | optica::Required() |
+        optica::Description<
+            "Local mode keeps data on this node, replicated mode copies every "
+            "write to all peers before it is acknowledged">(),
+    optica::Opt<"timeout", std::chrono::milliseconds>(),
+    optica::Opt<"sizes", std::array<int, 2>>() |
+        optica::Arity<optica::Exact<2>>(),
+    optica::Flag<"verbose">() | optica::ShortName<"v">() |
+        optica::Description<"Print more">());
+
+TEST_CASE("Usage is aligned and wrapped in compile time", "[usage]") {
+  constexpr std::string_view kExpected =
+      "Options:\n"
+      "  -t, --threads <int>            Number of worker threads\n"
+      "      --mode <local|replicated>  Local mode keeps data on this node, "
+      "replicated\n"
+      "                                 mode copies every write to all peers "
+      "before it\n"
+      "                                 is acknowledged (required)\n"
+      "      --timeout <duration>\n"
+      "      --sizes <int>...\n"
+      "  -v, --verbose                  Print more\n";
+  STATIC_REQUIRE(decltype(parser)::GetUsage() == kExpected);
+}
+
+TEST_CASE("Usage lines fit into width", "[usage]") {
+  constexpr auto usage = decltype(parser)::GetUsage();
+  std::size_t begin = 0;
+  while (begin < usage.size()) {
+    const std::size_t end = usage.find('\n', begin);
+    REQUIRE(end != std::string_view::npos);
+    REQUIRE(end - begin <= optica::details::kUsageWidth);
+    begin = end + 1;
+  }
+}
+
+TEST_CASE("Description of long name starts on next line", "[usage]") {
+  constexpr auto kParser = optica::Parser(
+      optica::Opt<"name", std::string_view>() |
+          optica::Description<"Short">(),
+      optica::Opt<"a-rather-long-option-name", double>() |
+          optica::Description<"Goes below">());
+
+  STATIC_REQUIRE(decltype(kParser)::GetUsage() ==
+                 "Options:\n"
+                 "      --name <string>  Short\n"
+                 "      --a-rather-long-option-name <float>\n"
+                 "                       Goes below\n");
+}
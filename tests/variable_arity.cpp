@@ -0,0 +1,97 @@
+#include <catch2/catch_all.hpp>
+#include <memory_resource>
+#include <optica/optica.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"files", std::vector<std::string>>() |
+        optica::ShortName<"f">() | optica::Arity<optica::AtLeast<1>>(),
+    optica::Opt<"ports", std::vector<int>>() | optica::ShortName<"p">() |
+        optica::Arity<optica::AtMost<3>>(),
+    optica::Opt<"ratios", std::vector<double>>() |
+        optica::Arity<optica::Between<2, 4>>(),
+    optica::Opt<"tags", std::pmr::vector<std::pmr::string>>() |
+        optica::Arity<optica::Any>(),
+    optica::Flag<"verbose">() | optica::ShortName<"v">());
+
+TEST_CASE("Variable arity stops at next option", "[arity]") {
+  auto result = parser.Parse(
+      "--files a.txt b.txt c.txt -p 80,443 --ratios 0.5 1.5 2.5 -v");
+
+  auto files = result.Get<"files">().value();
+  REQUIRE(files.size() == 3);
+  REQUIRE(files[2] == "c.txt");
+  REQUIRE(result.Get<"ports">().value() == std::vector<int>{80, 443});
+  REQUIRE(result.Get<"ratios">().value().size() == 3);
+  REQUIRE(result.Get<"verbose">().value());
+
+  auto empty = parser.Parse("--tags -v");
+  REQUIRE(empty.Get<"tags">().value().empty());
+  REQUIRE(empty.Get<"verbose">().value());
+}
+
+TEST_CASE("Variable arity checks bounds", "[arity]") {
+  using optica::ErrorCode;
+  REQUIRE(parser.TryParse("--files -v").error().code ==
+          ErrorCode::NotEnoughValues);
+  REQUIRE(parser.TryParse("--ratios 1").error().code ==
+          ErrorCode::NotEnoughValues);
+
+  // Fourth port isn't a value of --ports
+  auto extra = parser.TryParse("--ports 1 2 3 4");
+  REQUIRE_FALSE(extra.has_value());
+  REQUIRE(extra.error().code == ErrorCode::UnsupportedToken);
+  REQUIRE(extra.error().offset == 14);
+
+  auto invalid = parser.TryParse("-p8,x");
+  REQUIRE_FALSE(invalid.has_value());
+  REQUIRE(invalid.error().code == ErrorCode::InvalidValue);
+  REQUIRE(invalid.error().offset == 4);
+}
+
+TEST_CASE("Variable arity storage is sized once", "[arity]") {
+  struct CountingResource : std::pmr::memory_resource {
+    std::size_t allocations{};
+
+    void* do_allocate(std::size_t size, std::size_t alignment) override {
+      ++allocations;
+      return std::pmr::new_delete_resource()->allocate(size, alignment);
+    }
+    void do_deallocate(void* pointer, std::size_t size,
+                       std::size_t alignment) override {
+      std::pmr::new_delete_resource()->deallocate(pointer, size, alignment);
+    }
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+      return this == &other;
+    }
+  } resource;
+
+  decltype(parser)::ParseResultType result{&resource};
+  parser.ParseInto(result, "--tags a b c d e f g h");
+  REQUIRE(resource.allocations == 1);
+
+  parser.ParseInto(result, "--tags x y z");
+  REQUIRE(resource.allocations == 1);
+}
+
+namespace {
+template <typename Parser>
+concept AcceptsTemporary = requires(const Parser& parser) {
+  parser.Parse(std::string("--hosts a b"));
+};
+}  // namespace
+
+TEST_CASE("Borrowed values of variable arity refuse temporary input",
+          "[arity]") {
+  constexpr auto kHosts = optica::Parser(
+      optica::Opt<"hosts", std::vector<std::string_view>>() |
+      optica::Arity<optica::AtLeast<1>>());
+  STATIC_REQUIRE(decltype(kHosts)::ParseResultType::kBorrowsInput);
+  STATIC_REQUIRE_FALSE(AcceptsTemporary<decltype(kHosts)>);
+  STATIC_REQUIRE(AcceptsTemporary<decltype(parser)>);
+
+  const std::string input = "--hosts a b";
+  REQUIRE(kHosts.Parse(input).Get<"hosts">().value()[1] == "b");
+}
@@ -0,0 +1,97 @@
+#include <array>
+#include <catch2/catch_all.hpp>
+#include <optica/optica.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+constexpr auto parser = optica::Parser(
+    optica::Opt<"level", int>() | optica::Variant(1, 2, 3, 5, 8),
+    optica::Opt<"port", int>() | optica::Variant(80, 443, 8080, 65000),
+    optica::Opt<"mode", std::string>() |
+        optica::Variant("fast", "safe", "replicated"),
+    optica::Opt<"zone", std::string_view>() | optica::Variant("eu", "us"));
+
+TEST_CASE("Parsed values are checked against variants", "[variants]") {
+  auto result = parser.Parse(
+      "--level 5 --port 8080 --mode replicated --zone eu");
+  REQUIRE(result.Get<"level">().value() == 5);
+  REQUIRE(result.Get<"port">().value() == 8080);
+  REQUIRE(result.Get<"mode">().value() == "replicated");
+  REQUIRE(result.Get<"zone">().value() == "eu");
+
+  for (const char* input :
+       {"--level 4", "--port 81", "--mode slow", "--zone asia",
+        "--mode fas", "--level -1"}) {
+    auto parsed = parser.TryParse(input);
+    REQUIRE_FALSE(parsed.has_value());
+    REQUIRE(parsed.error().code == optica::ErrorCode::UnexpectedVariant);
+  }
+}
+
+TEST_CASE("Variant set picks structure by values", "[variants]") {
+  constexpr optica::details::VariantSet<int, 4> dense{
+      std::array{-3, 0, 100, 252}};
+  STATIC_REQUIRE(dense.IsDense());
+  STATIC_REQUIRE(dense.Contains(-3));
+  STATIC_REQUIRE(dense.Contains(252));
+  STATIC_REQUIRE_FALSE(dense.Contains(253));
+  STATIC_REQUIRE_FALSE(dense.Contains(-4));
+
+  constexpr optica::details::VariantSet<std::int64_t, 5> sparse{
+      std::array<std::int64_t, 5>{1'000'000, -7, 0, 1LL << 40, 300}};
+  STATIC_REQUIRE_FALSE(sparse.IsDense());
+  for (std::int64_t value : {-7LL, 0LL, 300LL, 1'000'000LL, 1LL << 40}) {
+    REQUIRE(sparse.Contains(value));
+  }
+  for (std::int64_t value : {-8LL, 1LL, 299LL, 999'999LL, (1LL << 40) + 1}) {
+    REQUIRE_FALSE(sparse.Contains(value));
+  }
+
+  // Only the chosen structure is stored
+  STATIC_REQUIRE(sizeof(sparse) < sizeof(std::array<std::int64_t, 5>) +
+                                      sizeof(optica::details::BitMask<256>));
+  constexpr optica::details::VariantSet<std::uint8_t, 3> bytes{
+      std::array<std::uint8_t, 3>{0, 128, 255}};
+  STATIC_REQUIRE(decltype(bytes)::kAlwaysDense);
+  STATIC_REQUIRE(bytes.Contains(255));
+  STATIC_REQUIRE_FALSE(bytes.Contains(254));
+}
+
+TEST_CASE("Error names option with unexpected variant", "[variants]") {
+  auto parsed = parser.TryParse("--level 2 --mode slow");
+  REQUIRE_FALSE(parsed.has_value());
+  REQUIRE(parsed.error().option_index == 2);
+  REQUIRE_THROWS_WITH(
+      parser.Parse("--mode slow"),
+      Catch::Matchers::ContainsSubstring("Value is not one of variants"));
+}
+
+TEST_CASE("Every value of list is checked against variants", "[variants]") {
+  constexpr auto kParser = optica::Parser(
+      optica::Opt<"levels", std::vector<int>>() | optica::Variant(1, 2, 3) |
+          optica::Arity<optica::Between<1, 4>>(),
+      optica::Opt<"zones", std::array<std::string_view, 2>>() |
+          optica::Variant("eu", "us") | optica::Arity<optica::Exact<2>>(),
+      optica::Opt<"mode", std::string_view>() | optica::Variant("fast", "safe"),
+      optica::Opt<"count", int>());
+
+  auto result = kParser.Parse("--levels 3 1 --zones us eu");
+  REQUIRE(result.Get<"levels">().value() == std::vector{3, 1});
+  REQUIRE(result.Get<"zones">().value()[1] == "eu");
+
+  auto level = kParser.TryParse("--levels 1 4 2");
+  REQUIRE_FALSE(level.has_value());
+  REQUIRE(level.error().code == optica::ErrorCode::UnexpectedVariant);
+  REQUIRE(level.error().offset == 11);
+
+  const char* argv[] = {"prog", "--zones", "eu,asia"};
+  auto zone = kParser.TryParse(3, argv);
+  REQUIRE_FALSE(zone.has_value());
+  REQUIRE(zone.error().code == optica::ErrorCode::UnexpectedVariant);
+
+  // Name after option is not its value
+  auto mode = kParser.TryParse("--mode --count 2");
+  REQUIRE_FALSE(mode.has_value());
+  REQUIRE(mode.error().code == optica::ErrorCode::NotEnoughValues);
+}